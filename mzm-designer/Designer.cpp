@@ -14,7 +14,9 @@
 #include <ctime>
 #include <memory>
 
+#include <mzmslv/SolverStats.hpp>
 #include <mzm/MazezamSolver/MazezamSolutionType.hpp>
+#include <mzm/MazezamSolver/MovesBound.hpp>
 #include "CursesInit.hpp"
 #include "MazezamPlayable.hpp"
 #include "MazezamPlayback.hpp"
@@ -36,6 +38,7 @@ using namespace mzmslv;
 
 Designer::Designer(bool useColors, int numThreads, std::ostream& os, unsigned int saveNum)
 : m_editor()
+, m_numThreads(numThreads)
 , m_workerPool(numThreads)
 , m_backgroundSolver(m_workerPool, *this)
 , m_outerWindow(CursesWindow::getOuterWindow())
@@ -52,6 +55,7 @@ Designer::Designer(bool useColors, int numThreads, std::ostream& os, unsigned in
 
 Designer::Designer(bool useColors, int numThreads, std::ostream& os, const mzm::MazezamData& startLevel, unsigned int saveNum)
 : m_editor(startLevel)
+, m_numThreads(numThreads)
 , m_workerPool(numThreads)
 , m_backgroundSolver(m_workerPool, *this)
 , m_outerWindow(CursesWindow::getOuterWindow())
@@ -64,7 +68,7 @@ Designer::Designer(bool useColors, int numThreads, std::ostream& os, const mzm::
 	m_useColors = initTerminal(useColors) && useColors;
 	setUpWindows();
 	m_editor.setObserver(this);
-	m_backgroundSolver.setNewLevel(startLevel, mzm::MAZEZAM_SOLUTION_FEWEST_PUSHES | mzm::MAZEZAM_SOLUTION_NUM_PUSHES | mzm::MAZEZAM_SOLUTION_NUM_MOVES | mzm::MAZEZAM_SOLUTION_RATING);
+	m_backgroundSolver.setNewLevel(startLevel, mzm::MAZEZAM_SOLUTION_FEWEST_PUSHES | mzm::MAZEZAM_SOLUTION_NUM_PUSHES | mzm::MAZEZAM_SOLUTION_NUM_MOVES | mzm::MAZEZAM_SOLUTION_MOVES_BOUND | mzm::MAZEZAM_SOLUTION_RATING);
 }
 
 bool Designer::initTerminal(bool useColors)
@@ -166,6 +170,8 @@ void Designer::drawSolutionInfo()
 		m_infoWindow->mvhline_(0, xoffset, ' ', CHARS_FOR_INFO);
 	if (m_summary.m_validSolutionFlags & mzm::MAZEZAM_SOLUTION_NUM_MOVES)
 		m_infoWindow->mvprintw_(1, xoffset, INT_INFO_ESCAPE_STRING(CHARS_FOR_INFO), m_summary.m_numMoves);
+	else if (m_summary.m_validSolutionFlags & mzm::MAZEZAM_SOLUTION_MOVES_BOUND)
+		m_infoWindow->mvprintw_(1, xoffset, INT_INFO_ESCAPE_STRING(CHARS_FOR_INFO_LESS_ONE) "~", m_summary.m_movesBound);
 	else
 		m_infoWindow->mvhline_(1, xoffset, ' ', CHARS_FOR_INFO);
 	if (m_summary.m_validSolutionFlags & mzm::MAZEZAM_SOLUTION_NUM_PUSHES)
@@ -174,6 +180,10 @@ void Designer::drawSolutionInfo()
 		m_infoWindow->mvhline_(2, xoffset, ' ', CHARS_FOR_INFO);
 	if (!m_summary.m_isSolvable)
 		m_infoWindow->attroff_(CursesWindow::A_REVERSE_);
+	if (m_summary.m_peakBytes >= 0)
+		m_infoWindow->mvprintw_(2, SOLUTION_DETAILS_OFFSET, INT_INFO_ESCAPE_STRING(CHARS_FOR_INFO), static_cast<unsigned int>((m_summary.m_peakBytes + 1023) / 1024));
+	else
+		m_infoWindow->mvhline_(2, SOLUTION_DETAILS_OFFSET, ' ', CHARS_FOR_INFO);
 
 	m_infoWindow->refresh_();
 	m_infoWindow->unlock();
@@ -205,6 +215,7 @@ void Designer::drawInfoHeaders()
 	m_infoWindow->getmaxyx_(maxy,maxx);
 	m_infoWindow->mvprintw_(0,0,"Level number:");
 	m_infoWindow->mvprintw_(1,0,"Improver radius:");
+	m_infoWindow->mvprintw_(2,0,"Peak memory (KB):");
 	//mvwprintw(m_infoWindow,1,0,"Solvable:");
 	m_infoWindow->mvprintw_(0,maxx / 2,"Rating:");
 	m_infoWindow->mvprintw_(1,maxx / 2,"# Moves:");
@@ -224,9 +235,10 @@ void Designer::update(Subject* subject)
 		}
 		// Blank the solution window.
 		m_summary.m_validSolutionFlags = 0;
+		m_summary.m_peakBytes = -1;
 		drawSolutionInfo();
 		// Start solving the level.
-		m_backgroundSolver.setNewLevel(m_editor.getLevel(), mzm::MAZEZAM_SOLUTION_FEWEST_PUSHES | mzm::MAZEZAM_SOLUTION_NUM_PUSHES | mzm::MAZEZAM_SOLUTION_NUM_MOVES | mzm::MAZEZAM_SOLUTION_RATING);
+		m_backgroundSolver.setNewLevel(m_editor.getLevel(), mzm::MAZEZAM_SOLUTION_FEWEST_PUSHES | mzm::MAZEZAM_SOLUTION_NUM_PUSHES | mzm::MAZEZAM_SOLUTION_NUM_MOVES | mzm::MAZEZAM_SOLUTION_MOVES_BOUND | mzm::MAZEZAM_SOLUTION_RATING);
 	} else
 		assert(false);
 }
@@ -357,7 +369,7 @@ Mode::ModeReturnValue Designer::modeLoop(CursesWindow& w, bool useColors, Mode*
 				// If we've found a solution
 				if (m_summary.m_isSolvable) {
 					m_mode = PLAYBACK;
-					MazezamPlayback mp(m_editor.getLevel(), m_summary.m_solution);
+					MazezamPlayback mp(m_editor.getLevel(), m_summary.m_solution.getPath());
 					drawHelpWindow(&mp);
 					ret = mp.modeLoop(*m_editorWindow, m_useColors, this);
 				}
@@ -371,12 +383,15 @@ Mode::ModeReturnValue Designer::modeLoop(CursesWindow& w, bool useColors, Mode*
 					// Wait until the background solver has rated the current level.
 					m_backgroundSolver.wait();
 					unsigned int oldFlags = m_summary.m_validSolutionFlags;
-					m_summary.m_validSolutionFlags &= ~mzm::MAZEZAM_SOLUTION_NUM_MOVES;
+					m_summary.m_validSolutionFlags &= ~(mzm::MAZEZAM_SOLUTION_NUM_MOVES | mzm::MAZEZAM_SOLUTION_MOVES_BOUND);
 
 					drawSolutionInfo();
+					// The improver gets all the processors while it runs.
+					m_workerPool.setNumThreads(mzmslv::WorkerPool::getNumProcessors());
 					Improver mi(m_editor.getLevel(), m_summary.m_rating, m_workerPool, *this, m_improverRadius, selection);
 					drawHelpWindow(&mi);
 					ret = mi.modeLoop(*m_editorWindow, m_useColors, this);
+					m_workerPool.setNumThreads(m_numThreads);
 					if (ret == ABANDON)
 					{
 						m_summary.m_validSolutionFlags = oldFlags;
@@ -385,9 +400,14 @@ Mode::ModeReturnValue Designer::modeLoop(CursesWindow& w, bool useColors, Mode*
 					else if (ret == EXIT)
 					{
 						mzm::MazezamData m = mi.getBestLevel();
-						// Improvement doesn't determine moves.
+						// Improvement doesn't determine moves, but the solution with the
+						// fewest pushes it found bounds them.
+						if (m_summary.m_isSolvable) {
+							m_summary.m_movesBound = mzm::findMovesBound(m_summary.m_solution);
+							m_summary.m_validSolutionFlags |= mzm::MAZEZAM_SOLUTION_MOVES_BOUND;
+						}
 						m_editor.setLevel(m);
-						m_backgroundSolver.setNewLevel(m, mzm::MAZEZAM_SOLUTION_NUM_MOVES );
+						m_backgroundSolver.setNewLevel(m, mzm::MAZEZAM_SOLUTION_NUM_MOVES);
 						ret = EDIT;
 					}
 					drawSolutionInfo();
@@ -422,15 +442,15 @@ void Designer::saveLevel(bool autoSave)
 	drawSaveNumInfo();
 }
 
-void Designer::collectSolution(unsigned int levelNumber, mzm::MazezamSolutionType solutionType, const mzm::MazezamSolutionSource& source)
+void Designer::collectSolution(unsigned int levelNumber, mzm::MazezamSolutionType solutionType, const mzm::MazezamSolution& solution)
 {
-	m_summary.m_isSolvable = source.isSolvable();
+	m_summary.m_isSolvable = solution.isSolvable();
 	if (m_summary.m_isSolvable) {
 		switch (solutionType) {
 			case mzm::MAZEZAM_SOLUTION_FEWEST_PUSHES:
-				m_summary.m_solution.clear();
 				m_summary.m_validSolutionFlags |= mzm::MAZEZAM_SOLUTION_FEWEST_PUSHES;
-				source.addToMzmPath(m_summary.m_solution);
+				// Its moves are only found if it is played back.
+				m_summary.m_solution = solution;
 				break;
 			default:
 				assert(false);
@@ -466,6 +486,19 @@ void Designer::collectNumMoves(unsigned int levelNumber, unsigned int numMoves)
 	drawSolutionInfo();
 }
 
+void Designer::collectMovesBound(unsigned int levelNumber, unsigned int numMoves)
+{
+	m_summary.m_validSolutionFlags |= mzm::MAZEZAM_SOLUTION_MOVES_BOUND;
+	m_summary.m_movesBound = numMoves;
+	drawSolutionInfo();
+}
+
+void Designer::collectSolverStats(unsigned int levelNumber, mzm::MazezamSolutionType solutionType, const mzmslv::SolverStats& stats)
+{
+	m_summary.m_peakBytes = stats.m_peakTotalBytes;
+	drawSolutionInfo();
+}
+
 void Designer::collectImprovement(unsigned int levelNumber, const mzm::MazezamData& level)
 {
 	// If there's an improvement, then it's solvable.
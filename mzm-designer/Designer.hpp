@@ -39,14 +39,14 @@ public:
 	class NCursesError { };
 	/*!
 	 * Constructor.
-	 * \param numThreads the number of extra solverThreads to use (must be 1 or greater).
+	 * \param numThreads the number of extra solverThreads to use (must be 1 or greater, or WorkerPool::AUTOMATIC_NUM_THREADS).
 	 * \param os if non-null, then an ostream to use for saving.
 	 * \param saveNum the number which the next level added to the save file would have.
 	 */
 	Designer(bool useColor, int numThreads, std::ostream& os, unsigned int saveNum = 1);
 	/*!
 	 * Constructor.
-	 * \param numThreads the number of extra solverThreads to use (must be 1 or greater).
+	 * \param numThreads the number of extra solverThreads to use (must be 1 or greater, or WorkerPool::AUTOMATIC_NUM_THREADS).
 	 * \param os if non-null, then an ostream to use for saving.
 	 * \param startLevel the level which should be opened at start.
 	 * \param saveNum the number which the next level added to the save file would have.
@@ -65,11 +65,13 @@ public:
 	virtual void update(Subject* subject);
 	
 	// SolutionCollector interface methods.
-	virtual void collectSolution(unsigned int levelNumber, mzm::MazezamSolutionType m_solutionType, const mzm::MazezamSolutionSource& source);
+	virtual void collectSolution(unsigned int levelNumber, mzm::MazezamSolutionType m_solutionType, const mzm::MazezamSolution& solution);
 	virtual void collectRating(unsigned int levelNumber, mzm::MazezamRating rating);
 	virtual void collectNumPushes(unsigned int levelNumber, unsigned int numPushes);
 	virtual void collectNumMoves(unsigned int levelNumber, unsigned int numMoves);
+	virtual void collectMovesBound(unsigned int levelNumber, unsigned int numMoves);
 	virtual void collectImprovement(unsigned int levelNumber, const mzm::MazezamData& level);
+	virtual void collectSolverStats(unsigned int levelNumber, mzm::MazezamSolutionType solutionType, const mzmslv::SolverStats& stats);
 
 	// Mode interface methods. 
 	virtual ModeReturnValue modeLoop(CursesWindow& w, bool useColors, Mode* parent = NULL);
@@ -80,6 +82,10 @@ private:
 	 * The editor.
 	 */
 	Editor m_editor;
+	/*!
+	 * The number of worker threads to use when not improving.
+	 */
+	int m_numThreads;
 	/*!
 	 * A pool of worker threads.
 	 */
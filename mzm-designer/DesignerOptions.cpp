@@ -27,7 +27,8 @@ const Options::OptionsInfo designerOptionsInfo[] = {
 	{"level",        required_argument, 0, 'l', "levelno",   "Start with the specified level"},
 	{"infile",       required_argument, 0, 'i', "infile",    "Load the level from this file"},
 	{"monochrome",   no_argument,       0, 'm', 0,           "Don't use colors even if available"},
-	{"threads",      required_argument, 0, 't', "numthreads","Number of threads to use"},
+	{"threads",      required_argument, 0, 't', "numthreads","Number of threads to use, or \"auto\""},
+	{"trace",        required_argument, 0, 'T', "tracefile", "Write a Chrome trace of the work to tracefile"},
 };
 
 const int NUM_OF_DESIGNER_OPTIONS_INFO = sizeof(designerOptionsInfo) / sizeof(Options::OptionsInfo);
@@ -41,6 +42,7 @@ DesignerOptions::DesignerOptions()
 , m_monochrome(false)
 , m_levelNumber(-1)
 , m_numThreads(2)
+, m_automaticNumThreads(false)
 {
 }
 
@@ -74,6 +76,9 @@ void DesignerOptions::handleOption(char optionChar, const char* optarg, const ch
 			break;
 		}
 		case 't': {
+			m_automaticNumThreads = (strcmp(optarg, "auto") == 0);
+			if (m_automaticNumThreads)
+				break;
 			std::stringstream arg(optarg);
 			arg >> m_numThreads;
 			errorIf(arg.fail(),"Bad thread number", optused, pname); 
@@ -84,6 +89,10 @@ void DesignerOptions::handleOption(char optionChar, const char* optarg, const ch
 			errorIf (m_inputFilename != "", "Input file already selected", optused, pname);
 			m_inputFilename = optarg;
 			break;
+		case 'T':
+			errorIf (m_traceFilename != "", "Trace file already selected", optused, pname);
+			m_traceFilename = optarg;
+			break;
 		case '?':
 		default:
 			throw HandledBadArgument();
@@ -139,10 +148,26 @@ unsigned int DesignerOptions::getNumThreads() const
 	return m_numThreads;
 }
 
+bool DesignerOptions::isAutomaticNumThreads() const
+{
+	return m_automaticNumThreads;
+}
+
+bool DesignerOptions::isTrace() const
+{
+	return m_traceFilename != "";
+}
+
+const std::string& DesignerOptions::getTraceFilename() const
+{
+	assert(isTrace());
+	return m_traceFilename;
+}
+
 
 void DesignerOptions::printUsage(std::ostream& os, const char* pname) const
 {
-	os << "Usage: " << pname << " [-i infile] [-l n] [-t numthreads] [-m] [outfile]\n";
+	os << "Usage: " << pname << " [-i infile] [-l n] [-t numthreads] [-m] [-T tracefile] [outfile]\n";
 	os << "Starts with the last or nth file, in \"out.mzm\" or infile, if specified.\n";
 	os << "Saves to \"out.mzm\" or outfile, if specified.\n";
 }
@@ -56,6 +56,18 @@ public:
 	 * Returns the number of threads to use. 
 	 */
 	unsigned int getNumThreads() const;
+	/*!
+	 * Return true iff the number of threads should be chosen automatically.
+	 */
+	bool isAutomaticNumThreads() const;
+	/*!
+	 * Return true iff a trace should be written.
+	 */
+	bool isTrace() const;
+	/*!
+	 * Returns the trace filename.
+	 */
+	const std::string& getTraceFilename() const;
 
 	virtual void parseOptions(int argc, char* argv[]);
 	virtual void printUsage(std::ostream& os, const char* pname) const;
@@ -97,6 +109,14 @@ public:
 	 * The number of threads to use.
 	 */
 	unsigned int m_numThreads;
+	/*!
+	 * Whether to choose the number of threads automatically.
+	 */
+	bool m_automaticNumThreads;
+	/*!
+	 * The file to write a trace to, or empty.
+	 */
+	std::string m_traceFilename;
 };
 
 #endif /*DESIGNEROPTIONS_H_*/
@@ -10,7 +10,9 @@
 #include "MazezamPlayback.hpp"
 
 #include <cassert>
+#include <algorithm>
 
+#include "CursesInit.hpp"
 #include "CursesWindow.hpp"
 #include "MazezamCurses.hpp"
 
@@ -24,7 +26,12 @@ MazezamPlayback::MazezamPlayback(const mzm::MazezamData& m, const mzm::mzm_path&
 : MazezamHistory(m, p, 0)
 , m_paused(false)
 , m_delay(DELAY_DEFAULT)
+, m_typedPush(0)
+, m_isTypingPush(false)
 {
+	for (unsigned int i = 0; i < p.size(); ++i)
+		if ((p[i] == mzm::DIR_PUSH_EAST) || (p[i] == mzm::DIR_PUSH_WEST))
+			m_pushEnds.push_back(i + 1);
 }
 
 MazezamPlayback::~MazezamPlayback()
@@ -34,6 +41,11 @@ MazezamPlayback::~MazezamPlayback()
 
 Mode::ModeReturnValue MazezamPlayback::processKey(CursesWindow& w, int k, Mode* next)
 {
+	// A push number is only gone to if g follows its digits straight away.
+	if (((k < '0') || (k > '9')) && (k != 'g') && (k != CursesWindow::ERR_)) {
+		m_typedPush = 0;
+		m_isTypingPush = false;
+	}
 	switch(k) {
 		case 'i':
 			if (m_delay > DELAY_MIN)
@@ -79,6 +91,28 @@ Mode::ModeReturnValue MazezamPlayback::processKey(CursesWindow& w, int k, Mode*
 				reset();
 			}
 			break;
+		case '[':
+			// Jump by a tenth of the solution.
+			pauseAt(w, getMoveIndex() - std::min(getMoveIndex(), std::max(getNumMoves() / 10, 1u)));
+			break;
+		case ']':
+			pauseAt(w, std::min(getNumMoves(), getMoveIndex() + std::max(getNumMoves() / 10, 1u)));
+			break;
+		case 'g':
+			// Go to the end of the typed push, or the start for push 0.
+			if (m_typedPush == 0)
+				pauseAt(w, 0);
+			else if (!m_pushEnds.empty())
+				pauseAt(w, m_pushEnds[std::min(m_typedPush, (unsigned int) m_pushEnds.size()) - 1]);
+			m_typedPush = 0;
+			m_isTypingPush = false;
+			break;
+		default:
+			if ((k >= '0') && (k <= '9') && (m_typedPush < 100000)) {
+				m_typedPush = (m_typedPush * 10) + (k - '0');
+				m_isTypingPush = true;
+			}
+			break;
 	}
 	if (next)
 		return next->processKey(w, k);
@@ -86,6 +120,27 @@ Mode::ModeReturnValue MazezamPlayback::processKey(CursesWindow& w, int k, Mode*
 		return LOOP;
 }
 
+void MazezamPlayback::pauseAt(CursesWindow& w, unsigned int index)
+{
+	m_paused = true;
+	w.nodelay_(false);
+	seek(index);
+}
+
+void MazezamPlayback::drawTypedPush(CursesWindow& w, bool useColors) const
+{
+	int maxy,maxx;
+	w.getmaxyx_(maxy,maxx);
+	// The row under the south wall, as placed by MazezamCurses::draw.
+	const int y = ((maxy - 1 - getHeight()) / 2) + getHeight() + 2;
+	if (y >= maxy)
+		return;
+	if (useColors) w.attron_(CursesWindow::COLOR_PAIR_(NORMAL_COLORS));
+	w.mvhline_(y, 0, ' ', maxx);
+	if (m_isTypingPush)
+		w.mvprintw_(y, (maxx - 16) / 2, "Go to push %u", m_typedPush);
+}
+
 Mode::ModeReturnValue MazezamPlayback::modeLoop(CursesWindow& w, bool useColors, Mode* parent)
 {
 	// Make cursor invisible.
@@ -100,6 +155,7 @@ Mode::ModeReturnValue MazezamPlayback::modeLoop(CursesWindow& w, bool useColors,
 		if (!canRedo())
 			w.nodelay_(false);
 		MazezamCurses::draw(&w, useColors, *this);
+		drawTypedPush(w, useColors);
 		w.refresh_();
 		ret = parent->processKey(w, w.getch_(), this);
 	} while (ret == LOOP);
@@ -122,6 +178,8 @@ KeyHelp MazezamPlaybackHelpKeys[] = {
 	{"p", "pause/play"},
 	{"SPACE", "next"},
 	{"b", "back"},
+	{"[/]", "back/forward 10%"},
+	{"0-9 g", "go to push"},
 	{"i", "increase speed"},
 	{"d", "decrease speed"},
 };
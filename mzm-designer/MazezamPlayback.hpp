@@ -10,6 +10,8 @@
 #ifndef MAZEZAMPLAYBACK_H_
 #define MAZEZAMPLAYBACK_H_
 
+#include <vector>
+
 #include <mzm/Mazezam/MazezamHistory.hpp>
 #include "Mode.hpp"
 
@@ -50,6 +52,27 @@ public:
 	 */
 	int m_delay;
 private:
+	/*!
+	 * The number of moves made by the end of each push.
+	 */
+	std::vector<unsigned int> m_pushEnds;
+	/*!
+	 * The push number being typed, to go to.
+	 */
+	unsigned int m_typedPush;
+	/*!
+	 * Is a push number being typed.
+	 */
+	bool m_isTypingPush;
+
+	/*!
+	 * Pause playback and go to a point in the solution.
+	 */
+	void pauseAt(CursesWindow& w, unsigned int index);
+	/*!
+	 * Show the push number being typed under the level, if there is room.
+	 */
+	void drawTypedPush(CursesWindow& w, bool useColors) const;
 	/*!
 	 * Copy constructor. Private and unimplemented.
 	 */
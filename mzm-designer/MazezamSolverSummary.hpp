@@ -12,6 +12,7 @@
 
 #include <mzm/Mazezam/TypesAndConstants.hpp>
 #include <mzm/MazezamSolver/MazezamRatingType.hpp>
+#include <mzm/MazezamSolver/MazezamSolution.hpp>
 
 /*!
  * Collects useful information about the solver outcome.
@@ -20,9 +21,9 @@ struct MazezamSolverSummary {
 	/*!
 	 * Constructor.
 	 */
-	MazezamSolverSummary() : m_validSolutionFlags(0) {}
+	MazezamSolverSummary() : m_validSolutionFlags(0), m_peakBytes(-1) {}
 	/*!
-	 * Which of the rating / pushes / moves are valid.
+	 * Which of the rating / pushes / moves (or a bound on them) are valid.
 	 */
 	unsigned int m_validSolutionFlags;
 	/*!
@@ -35,9 +36,9 @@ struct MazezamSolverSummary {
 	 */
 	mzm::MazezamRating m_rating;
 	/*!
-	 * The solution found (as an mzm_path).
+	 * The solution found, whose moves are found when it is played back.
 	 */
-	mzm::mzm_path m_solution;
+	mzm::MazezamSolution m_solution;
 	/*!
 	 * The number of pushes in the solution.
 	 */
@@ -46,6 +47,15 @@ struct MazezamSolverSummary {
 	 * The number of moves in the solution.
 	 */
 	unsigned int m_numMoves;
+	/*!
+	 * A number of moves with which the level can be solved, shown until
+	 * the number in the solution with the fewest moves is known.
+	 */
+	unsigned int m_movesBound;
+	/*!
+	 * The most memory used by the search, in bytes, or -1 if it isn't known.
+	 */
+	long m_peakBytes;
 };
 
 #endif /*MAZEZAMSOLVERSUMMARY_H_*/
@@ -10,6 +10,7 @@
 #include<iostream>
 #include<fstream>
 
+#include <mzmcommon/Tracer/Tracer.hpp>
 #include <mzm/MzmReaders/FileMzmReader.hpp>
 #include <mzm/MzmReaders/DummyOStream.hpp>
 
@@ -62,19 +63,20 @@ static void helpMessage(const DesignerOptions& opt, const char* pname)
  */
 static void design(const DesignerOptions& opt, std::ostream& outstream, MazezamData *startLevel, int levelNum)
 {
+	// The designer uses one thread itself.
+	const int numPoolThreads = opt.isAutomaticNumThreads() ? mzmslv::WorkerPool::AUTOMATIC_NUM_THREADS : opt.getNumThreads() - 1;
 	if (startLevel) {
 		/*
-		MazezamSolverJobFewestPushes job(*startLevel);
+		SharedLevel level(*startLevel);
+		MazezamSolverJobFewestPushes<mzm_row> job(level);
 		job.doJob();
-		mzm_path path;
-		job.addToMzmPath(path);
-		std::cout << path << "\n";
+		std::cout << job.getSolution().getPath() << "\n";
 		*/
-		Designer d(!opt.isMonochrome(), opt.getNumThreads() - 1, outstream, *startLevel, levelNum );
+		Designer d(!opt.isMonochrome(), numPoolThreads, outstream, *startLevel, levelNum );
 		delete startLevel;
 		d.designLevel();
 	} else {
-		Designer d(!opt.isMonochrome(), opt.getNumThreads() - 1, outstream, levelNum );
+		Designer d(!opt.isMonochrome(), numPoolThreads, outstream, levelNum );
 		d.designLevel();
 	}
 }
@@ -146,7 +148,15 @@ static int handleFiles(const DesignerOptions& opt)
 		} else
 			levelNum = 1;
 	}
+	if (opt.isTrace()) {
+		if (!Tracer::start(opt.getTraceFilename())) {
+			std::cerr << "Cannot open trace file " << opt.getTraceFilename() << std::endl;
+			return 1;
+		}
+		Tracer::nameThread("designer");
+	}
 	design(opt, outstream, startLevel, levelNum);
+	Tracer::stop();
 	return 0;
 }
 extern int solve(int argc, char* argv[]);
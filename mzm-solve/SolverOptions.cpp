@@ -28,7 +28,8 @@ const Options::OptionsInfo solverOptionsInfo[] = {
 	{"version",      no_argument,       0, 'v', 0,          "Print version information"},
 	{"any-solution", no_argument,       0, 'a', 0,          "Find any solution"},
 	{"pushes-only",  no_argument,       0, 'p', 0,          "Only find solution with fewest pushes"},
-	{"moves-only",   no_argument,       0, 'm', 0,          "Only find solution with fewest moves"},
+	{"moves-only",   no_argument,       0, 'm', 0,          "Only find solution with fewest moves (then pushes)"},
+	{"pushes-then-moves", no_argument,  0, 'u', 0,          "Only find solution with fewest pushes, then moves"},
 	{"both",         no_argument,       0, 'b', 0,          "Give both optimal solutions (default)"},
 	{"copy",         no_argument,       0, 'c', 0,          "Copy input to output"},
 	{"defaults",     no_argument,       0, 'd', 0,          "Use built-in default levels"},
@@ -37,6 +38,11 @@ const Options::OptionsInfo solverOptionsInfo[] = {
 	{"levels",       required_argument, 0, 'l', "levelspec","Only solve specified levels"},
 	{"output",       required_argument, 0, 'o', "outfile",   "Write output to outfile"},
 	{"threads",      required_argument, 0, 't', "numthreads","Number of threads to use"},
+	{"pin",          no_argument,       0, 'P', 0,           "Pin each thread to a processor"},
+	{"pool-stats",   no_argument,       0, 'S', 0,           "Print thread and job timings to stderr"},
+	{"perf-counters", no_argument,      0, 'C', 0,           "Print hardware event counts of each search to stderr"},
+	{"memory-stats", no_argument,       0, 'M', 0,           "Print the memory used by each search to stderr"},
+	{"trace",        required_argument, 0, 'T', "tracefile", "Write a Chrome trace of the work to tracefile"},
 };
 
 /*!
@@ -54,6 +60,10 @@ SolverOptions::SolverOptions()
 , m_doRating(false)
 , m_doOutputFile(false)
 , m_doAStar(false)
+, m_doPin(false)
+, m_doPoolStats(false)
+, m_doPerfCounters(false)
+, m_doMemoryStats(false)
 , m_sourceMode(STDIN)
 , m_solutionFlags(0)
 , m_numThreads(2)
@@ -101,6 +111,10 @@ void SolverOptions::handleOption(char optionChar, const char* optarg, const char
 			errorIf ((m_solutionFlags & MAZEZAM_SOLUTION_SEARCHES) & ~MAZEZAM_SOLUTION_FEWEST_MOVES, "Cannot also select fewest moves", optused, pname);
 			m_solutionFlags |= MAZEZAM_SOLUTION_FEWEST_MOVES;
 			break;
+		case 'u':
+			errorIf ((m_solutionFlags & MAZEZAM_SOLUTION_SEARCHES) & ~MAZEZAM_SOLUTION_FEWEST_PUSHES_THEN_MOVES, "Cannot also select fewest pushes then moves", optused, pname);
+			m_solutionFlags |= MAZEZAM_SOLUTION_FEWEST_PUSHES_THEN_MOVES;
+			break;
 		case 'a':
 			errorIf ((m_solutionFlags & MAZEZAM_SOLUTION_SEARCHES) & ~MAZEZAM_SOLUTION_FASTEST, "Cannot also select any solution", optused, pname);
 			m_solutionFlags |= MAZEZAM_SOLUTION_FASTEST;
@@ -125,6 +139,22 @@ void SolverOptions::handleOption(char optionChar, const char* optarg, const char
 		case 'A':
 			m_doAStar = true;
 			break;
+		case 'P':
+			m_doPin = true;
+			break;
+		case 'S':
+			m_doPoolStats = true;
+			break;
+		case 'C':
+			m_doPerfCounters = true;
+			break;
+		case 'M':
+			m_doMemoryStats = true;
+			break;
+		case 'T':
+			errorIf (m_traceFilename != "", "Trace file already selected", optused, pname);
+			m_traceFilename = optarg;
+			break;
 		case 't': {
 			std::stringstream arg(optarg);
 			int num;
@@ -222,9 +252,40 @@ unsigned int SolverOptions::getNumThreads() const
 	return m_numThreads;
 }
 
+bool SolverOptions::isPin() const
+{
+	return m_doPin;
+}
+
+bool SolverOptions::isPoolStats() const
+{
+	return m_doPoolStats;
+}
+
+bool SolverOptions::isPerfCounters() const
+{
+	return m_doPerfCounters;
+}
+
+bool SolverOptions::isMemoryStats() const
+{
+	return m_doMemoryStats;
+}
+
+bool SolverOptions::isTrace() const
+{
+	return m_traceFilename != "";
+}
+
+const std::string& SolverOptions::getTraceFilename() const
+{
+	assert(isTrace());
+	return m_traceFilename;
+}
+
 void SolverOptions::printUsage(std::ostream& os, const char* pname) const
 {
-	os << "Usage: " << pname << " [-h|-v| [-a|-m|-p|-b] [-o outfile] [-r] [[-c] [infile] | -d]]\n";
+	os << "Usage: " << pname << " [-h|-v| [-a|-m|-p|-u|-b] [-o outfile] [-r] [[-c] [infile] | -d]]\n";
 	os << "If no input file is specified, the program reads from standard input. Input\n";
 	os << "must be in \".mzm\" format.\n";
 	
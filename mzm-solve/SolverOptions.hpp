@@ -93,6 +93,30 @@ public:
 	 * 
 	 */
 	unsigned int getNumThreads() const;
+	/*!
+	 * Return true iff the threads should be pinned to processors.
+	 */
+	bool isPin() const;
+	/*!
+	 * Return true iff the pool's timings should be printed.
+	 */
+	bool isPoolStats() const;
+	/*!
+	 * Return true iff the hardware event counts of the searches should be printed.
+	 */
+	bool isPerfCounters() const;
+	/*!
+	 * Return true iff the memory used by the searches should be printed.
+	 */
+	bool isMemoryStats() const;
+	/*!
+	 * Return true iff a trace should be written.
+	 */
+	bool isTrace() const;
+	/*!
+	 * Returns the trace filename.
+	 */
+	const std::string& getTraceFilename() const;
 	/*!
 	 * Print out a usage message.
 	 * \param os the output stream.
@@ -134,6 +158,26 @@ private:
 	 * Whether to use A*.
 	 */
 	bool m_doAStar;
+	/*!
+	 * Whether to pin threads to processors.
+	 */
+	bool m_doPin;
+	/*!
+	 * Whether to print the pool's timings.
+	 */
+	bool m_doPoolStats;
+	/*!
+	 * Whether to print the hardware event counts of the searches.
+	 */
+	bool m_doPerfCounters;
+	/*!
+	 * Whether to print the memory used by the searches.
+	 */
+	bool m_doMemoryStats;
+	/*!
+	 * The file to write a trace to, or empty.
+	 */
+	std::string m_traceFilename;
 	/*!
 	 * Specifies the source of levels.
 	 */
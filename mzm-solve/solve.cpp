@@ -10,6 +10,7 @@
 #include <iostream>
 #include <fstream>
 
+#include <mzmcommon/Tracer/Tracer.hpp>
 #include <mzm/MzmReaders/DummyOStream.hpp>
 #include <mzm/MzmReaders/FileMzmReader.hpp>
 #include <mzm/MzmReaders/SelectiveMzmReader.hpp>
@@ -17,6 +18,7 @@
 #include <mzm/MazezamSolver/OfflineSolver.hpp>
 #include <mzm/MazezamSolver/MazezamSolutionType.hpp>
 #include <mzm/MazezamSolver/OutstreamSolutionCollector.hpp>
+#include <mzmslv/PerfCounters.hpp>
 
 #include "SolverOptions.hpp"
 
@@ -62,8 +64,20 @@ void processLevels (const SolverOptions& opt, MzmReader& r, std::ostream& os)
 {
 	OutstreamSolutionCollector collector(os, opt.getSolutionFlags(), opt.isCopyMode());
 	WorkerPool workerPool(opt.getNumThreads() - 1);
+	if (opt.isPin() && !workerPool.setPinned(true))
+		std::cerr << "Warning: could not pin threads to processors\n";
+	if (opt.isPerfCounters() || opt.isMemoryStats())
+		collector.setStatsStream(&std::cerr);
+	if (opt.isPerfCounters()) {
+		if (PerfCounters::isAvailable())
+			PerfCounters::setEnabled(true);
+		else
+			std::cerr << "Warning: could not open hardware performance counters\n";
+	}
 	OfflineSolver solver(r, workerPool, collector, opt.getSolutionFlags(), opt.isCopyMode());
 	solver.solve();
+	if (opt.isPoolStats())
+		std::cerr << workerPool.getStats();
 }
 
 /*!
@@ -161,6 +175,32 @@ void handleOutputSelection (const SolverOptions& opt)
 		handleInputSelection(opt,std::cout);
 }
 
+/*!
+ * Determine whether the user has asked for a trace and process.
+ * \param opt the options object.
+ * \return false if the trace file cannot be opened.
+ */
+bool handleTraceSelection (const SolverOptions& opt)
+{
+	if (opt.isTrace()) {
+		if (!Tracer::start(opt.getTraceFilename())) {
+			std::cerr << "Cannot open trace file " << opt.getTraceFilename() << "\n";
+			return false;
+		}
+		Tracer::nameThread("main");
+		try {
+			handleOutputSelection(opt);
+		} catch (...) {
+			// The file has been started, so finish it.
+			Tracer::stop();
+			throw;
+		}
+		Tracer::stop();
+	} else
+		handleOutputSelection(opt);
+	return true;
+}
+
 int main (int argc, char* argv[]) 
 {
 	try {
@@ -170,8 +210,8 @@ int main (int argc, char* argv[])
 			helpMessage(opt, argv[0]);
 		else if (opt.isVersion())
 			versionMessage(argv[0]);
-		else
-			handleOutputSelection(opt);
+		else if (!handleTraceSelection(opt))
+			return 1;
 		return 0;
 	} catch (Options::HandledBadArgument e) {
 		// The option parser prints out its own error messages, so do nothing.
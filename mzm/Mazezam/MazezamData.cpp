@@ -81,7 +81,7 @@ MazezamData::MazezamData(array_type& block, mzm_coord h, mzm_coord w, mzm_coord
 			found = false;
 			for (int x = 0; x < m_width; ++x) {
 				if (block[y][x]) {
-					m_row[y] |= (1 << (m_width - x - 1));
+					m_row[y] |= ((mzm_row) 1 << (m_width - x - 1));
 					found = true;
 				}
 				else if (!found) {
@@ -166,7 +166,7 @@ bool MazezamData::canSetDimensions(mzm_coord h, mzm_coord w) const
 			return false;
 	if (w < m_width) {
 		for (int y = 0; y < h; ++y)
-			if ((m_row[y] >> m_inset[y]) & ((1 << (m_width - w)) - 1))
+			if ((m_row[y] >> m_inset[y]) & (((mzm_row) 1 << (m_width - w)) - 1))
 				return false;
 	}
 	return true;
@@ -220,13 +220,13 @@ bool MazezamData::checkInsets(const mzm_coord* inset) const
 		assert(inset[i] >= 0);
 		if (m_row[i]) {
 			// Check the row is left aligned.
-			assert(m_row[i] & (1 << (m_width - 1)));
+			assert(m_row[i] & ((mzm_row) 1 << (m_width - 1)));
 			// Check the row is zero beyond the first block.
-			assert((m_row[i] & ~((mzm_row)((1 << m_width) - 1))) == 0);
+			assert((m_row[i] & ~(((mzm_row) 1 << m_width) - 1)) == 0);
 			if (inset[i]) 
 			{
 				// Check that the row can fit when adjusted by the inset.
-				assert(0 == (m_row[i] & (1 << (inset[i] - 1)))); 
+				assert(0 == (m_row[i] & ((mzm_row) 1 << (inset[i] - 1)))); 
 			}
 		} else
 			assert (inset[i] == m_width);
@@ -243,7 +243,7 @@ bool MazezamData::isValid() const
 	// The row data fits in the size.
 	for (int i = 0; i < m_height; ++i) {
 		if (m_width < MAX_MAZEZAM_WIDTH)
-			assert (m_row[i] < (mzm_row) (1 << m_width));
+			assert (m_row[i] < ((mzm_row) 1 << m_width));
 	}
 	assert((m_start >= 0) && (m_start < m_height));
 	assert((m_finish >= 0) && (m_finish < m_height));
@@ -283,20 +283,20 @@ void MazezamData::setBlock(mzm_coord y, mzm_coord x, bool b) {
 		if (x < m_inset[y]) {
 			m_row[y] >>= (m_inset[y] - x);
 			m_inset[y] = x;
-			m_row[y] |= 1 << (m_width - 1);
+			m_row[y] |= (mzm_row) 1 << (m_width - 1);
 		} else {
-			m_row[y] |= 1 << (m_width + m_inset[y] - x - 1);
+			m_row[y] |= (mzm_row) 1 << (m_width + m_inset[y] - x - 1);
 		}
 	} else {
 		if (x > m_inset[y]) {
-			m_row[y] &= ~(1 << (m_width + m_inset[y] - x - 1));	
+			m_row[y] &= ~((mzm_row) 1 << (m_width + m_inset[y] - x - 1));	
 		} else {
-			m_row[y] &= ~(1 << (m_width - 1));
+			m_row[y] &= ~((mzm_row) 1 << (m_width - 1));
 			if (m_row[y]) {
 				do {
 					m_row[y] <<= 1;
 					++m_inset[y];
-				} while (!(m_row[y] & (1 << (m_width - 1))));
+				} while (!(m_row[y] & ((mzm_row) 1 << (m_width - 1))));
 			} else
 				m_inset[y] = m_width;
 		}
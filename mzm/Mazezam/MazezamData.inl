@@ -11,7 +11,7 @@ namespace mzm {
 bool MazezamData::getBlock(mzm_coord y, mzm_coord x) const {
 	assert(y < m_height);
 	assert(x < m_width);
-	return ((m_row[y] >> m_inset[y]) & (1 << ((m_width - 1) - x)));
+	return ((m_row[y] >> m_inset[y]) & ((mzm_row) 1 << ((m_width - 1) - x)));
 }
 
 bool MazezamData::canShiftWest(mzm_coord r) const
@@ -9,84 +9,86 @@
 
 #include <mzm/Mazezam/MazezamHistory.hpp>
 
+#include <algorithm>
+
 namespace mzm {
 
 MazezamHistory::MazezamHistory(const MazezamData& m)
 : MazezamPerson(m)
-, m_iterator(m_path.begin())
+, m_index(0)
 {
+	addCheckpoint();
 }
 
 MazezamHistory::MazezamHistory(const MazezamData& m, const mzm_path& p, int index)
 : MazezamPerson(m)
 , m_path(p)
-, m_iterator(m_path.begin())
+, m_index(0)
 {
-	if (index < 0)
-		index = p.size();
-	for (int i = 0; i < index; ++i)
+	// Go all the way along the path first, so there are checkpoints along all of it.
+	addCheckpoint();
+	while (canRedo())
 		redo();
+	if (index >= 0)
+		seek(index);
 }
 
 void MazezamHistory::moveNorth() 
 {
 	MazezamPerson::moveNorth();
-	m_path.erase(m_iterator, m_path.end());
-	m_path.push_back(DIR_NORTH);
-	m_iterator = m_path.end();
+	recordMove(DIR_NORTH);
 }
 
 void MazezamHistory::moveSouth()
 {
 	MazezamPerson::moveSouth();
-	m_path.erase(m_iterator, m_path.end());
-	m_path.push_back(DIR_SOUTH);
-	m_iterator = m_path.end();
+	recordMove(DIR_SOUTH);
 }
 
 void MazezamHistory::moveEast()
 {
 	MazezamPerson::moveEast();
-	m_path.erase(m_iterator, m_path.end());
-	m_path.push_back(DIR_EAST);
-	m_iterator = m_path.end();
+	recordMove(DIR_EAST);
 }
 
 void MazezamHistory::moveWest()
 {
 	MazezamPerson::moveWest();
-	m_path.erase(m_iterator, m_path.end());
-	m_path.push_back(DIR_WEST);
-	m_iterator = m_path.end();
+	recordMove(DIR_WEST);
 }
 
 void MazezamHistory::pushEast()
 {
 	MazezamPerson::pushEast();
-	m_path.erase(m_iterator, m_path.end());
-	m_path.push_back(DIR_PUSH_EAST);
-	m_iterator = m_path.end();
+	recordMove(DIR_PUSH_EAST);
 }
 
 void MazezamHistory::pushWest()
 {
 	MazezamPerson::pushWest();
-	m_path.erase(m_iterator, m_path.end());
-	m_path.push_back(DIR_PUSH_WEST);
-	m_iterator = m_path.end();
+	recordMove(DIR_PUSH_WEST);
+}
+
+void MazezamHistory::recordMove(mzm_direction d)
+{
+	m_path.resize(m_index);
+	// Checkpoints after this point are of the moves being replaced.
+	m_checkpoints.resize(m_index / CHECKPOINT_INTERVAL + 1);
+	m_path.push_back(d);
+	++m_index;
+	addCheckpoint();
 }
 
 void MazezamHistory::reset()
 {
-	while (canUndo())
-		undo();
+	seek(0);
 }
 
 void MazezamHistory::undo()
 {
 	assert(canUndo());
-	--m_iterator;
-	switch (*m_iterator) {
+	--m_index;
+	switch (m_path[m_index]) {
 		case DIR_NORTH:
 			MazezamPerson::moveSouth();
 			break;
@@ -113,7 +115,7 @@ void MazezamHistory::undo()
 void MazezamHistory::redo()
 {
 	assert(canRedo());
-	switch (*m_iterator) {
+	switch (m_path[m_index]) {
 		case DIR_NORTH:
 			assert (canMoveNorth());
 			MazezamPerson::moveNorth();
@@ -139,17 +141,65 @@ void MazezamHistory::redo()
 			MazezamPerson::pushWest();
 			break;
 	}
-	++m_iterator;
+	++m_index;
+	addCheckpoint();
 }
 
 bool MazezamHistory::canUndo()
 {
-	return m_iterator != m_path.begin();
+	return m_index != 0;
 }
 
 bool MazezamHistory::canRedo()
 {
-	return m_iterator != m_path.end();
+	return m_index != m_path.size();
+}
+
+void MazezamHistory::seek(unsigned int index)
+{
+	assert(index <= m_path.size());
+	const unsigned int i = std::min(index / CHECKPOINT_INTERVAL, (unsigned int) m_checkpoints.size() - 1);
+	const unsigned int checkpointIndex = i * CHECKPOINT_INTERVAL;
+	if (m_index > index) {
+		// Undo if that's no further than redoing from the checkpoint.
+		if (m_index - index <= index - checkpointIndex) {
+			while (m_index > index)
+				undo();
+			return;
+		}
+		restoreCheckpoint(i);
+	} else if (m_index < checkpointIndex) {
+		restoreCheckpoint(i);
+	}
+	while (m_index < index)
+		redo();
+}
+
+void MazezamHistory::addCheckpoint()
+{
+	if ((m_index % CHECKPOINT_INTERVAL != 0) || (m_index / CHECKPOINT_INTERVAL != m_checkpoints.size()))
+		return;
+	Checkpoint checkpoint;
+	checkpoint.m_inset.resize(getHeight());
+	for (mzm_coord r = 0; r < getHeight(); ++r)
+		checkpoint.m_inset[r] = getInset(r);
+	checkpoint.m_y = getY();
+	checkpoint.m_x = getX();
+	m_checkpoints.push_back(checkpoint);
+}
+
+void MazezamHistory::restoreCheckpoint(unsigned int i)
+{
+	assert(i < m_checkpoints.size());
+	const Checkpoint& checkpoint = m_checkpoints[i];
+	for (mzm_coord r = 0; r < getHeight(); ++r) {
+		while (getInset(r) < checkpoint.m_inset[r])
+			shiftEast(r);
+		while (getInset(r) > checkpoint.m_inset[r])
+			shiftWest(r);
+	}
+	setPosition(checkpoint.m_y, checkpoint.m_x);
+	m_index = i * CHECKPOINT_INTERVAL;
 }
 
 void MazezamHistory::pullEast()
@@ -10,12 +10,16 @@
 #ifndef MAZEZAMHISTORY_H_
 #define MAZEZAMHISTORY_H_
 
+#include <vector>
+
 #include <mzm/Mazezam/MazezamPerson.hpp>
 
 namespace mzm {
 
 /*!
  * A MazezamPerson that preserves the person's journey and supports resetting, undoing and redoing.
+ * The state of the level is kept every CHECKPOINT_INTERVAL moves along the journey, so any point
+ * of it can be reached without replaying it from the start.
  */
 class MazezamHistory : public MazezamPerson
 {
@@ -51,6 +55,19 @@ public:
 	 * Redo the last undone move.
 	 */
 	virtual void redo();
+	/*!
+	 * Go to a point in the journey, undoing or redoing moves as needed.
+	 * \param index the number of moves from the start, which must be at most getNumMoves().
+	 */
+	void seek(unsigned int index);
+	/*!
+	 * The number of moves the person has made from the start.
+	 */
+	inline unsigned int getMoveIndex() const { return m_index; }
+	/*!
+	 * The number of moves in the journey, including those which have been undone.
+	 */
+	inline unsigned int getNumMoves() const { return m_path.size(); }
 	
 	// MazezamPerson methods.
 	virtual void moveNorth();
@@ -71,14 +88,45 @@ protected:
 	 */
 	virtual void pullWest();
 private:
+	/*!
+	 * The number of moves between checkpoints.
+	 */
+	static const unsigned int CHECKPOINT_INTERVAL = 64;
+	/*!
+	 * The state of the level at a point in the journey.
+	 */
+	struct Checkpoint {
+		std::vector<mzm_coord> m_inset;
+		mzm_coord m_y;
+		mzm_coord m_x;
+	};
+	/*!
+	 * The state after every CHECKPOINT_INTERVAL moves of the path, as far as
+	 * the person has been along it.
+	 */
+	std::vector<Checkpoint> m_checkpoints;
 	/*!
 	 * A path of moves from the start.
 	 */
 	mzm_path m_path;
 	/*!
-	 * The point in the path the character is currently at.
+	 * The index of the move in the path the character would make next.
+	 */
+	unsigned int m_index;
+
+	/*!
+	 * Add a move to the path after the current point, replacing the rest of it.
+	 */
+	void recordMove(mzm_direction d);
+	/*!
+	 * Keep the state at the current point, if it is due a checkpoint which
+	 * hasn't been kept yet.
+	 */
+	void addCheckpoint();
+	/*!
+	 * Return to the state kept by a checkpoint.
 	 */
-	mzm_path::iterator m_iterator;
+	void restoreCheckpoint(unsigned int i);
 };
 
 } // namespace mzm
@@ -10,8 +10,7 @@
 #include <mzm/Mazezam/MazezamPerson.hpp>
 #include <cassert>
 
-#include <mzmslv/Solver.hpp>
-#include <mzm/MazezamSolver/ConfigWalk.hpp>
+#include <mzm/MazezamSolver/WalkFinder.hpp>
 
 namespace mzm {
 
@@ -121,33 +120,34 @@ bool MazezamPerson::findPath(mzm_coord y, mzm_coord x, mzm_path& p) const
 	assert (y < getHeight());
 	assert ((x >= 0) || ((x == -1) && (y == getStart()))); 
 	assert ((x < getWidth()) || ((x == getWidth()) && (y == getFinish())));
-	// The MazezamSolver doesn't account for the final position:
-	const mzm_coord targetX = (x == getWidth()) ? (x - 1) : x;
-	// The MazezamSolver doesn't account for the start position:
+	// The walk is within the level, so the entrance and the exit are reached
+	// from the positions next to them.
+	const mzm_coord targetX = (x == getWidth()) ? (x - 1) : ((x == -1) ? 0 : x);
+	if ((m_x == -1) && (x == -1))
+		return true;
+	mzm_path walk;
 	mzm_coord currentX = m_x;
-	if (x == -1) {
-		currentX = 0;
-		p.push_back(DIR_EAST);
-	}
 	mzm_coord currentY = m_y;
-	// We use a breadth-first search to find the shortest way of walking to the target.
-	mzmslv::Solver<ConfigWalk> s;
-	mzmslv::Solver<ConfigWalk>::path cp;
-	ConfigWalk* init = new ConfigWalk(*this, currentX, currentY, targetX, y);
-	mzmslv::SolverResult b = s.findSolutionBreadthFirst(init, cp);
-	if (b == mzmslv::FOUND_SOLUTION) {
-		// add the moves corresponding to the walk.
-		for(unsigned int i = 0; i < cp.size() - 1; ++i)
-			cp[i]->addMoves(*cp[i+1], p, currentX, currentY);
+	if (currentX == -1) {
+		if (getBlock(currentY, 0))
+			return false;
+		currentX = 0;
+		walk.push_back(DIR_EAST);
 	}
-	// delete the configurations in the solution path.
-	mzmslv::Solver<ConfigWalk>::deletePath(cp);
-	// It is an error if we cannot find such a walk.
-	if (b != mzmslv::FOUND_SOLUTION)
+	// We look for the shortest way of walking to the target.
+	std::vector<mzm_coord> inset(getHeight());
+	for (int i = 0; i < getHeight(); ++i)
+		inset[i] = getInset(i);
+	WalkFinder<mzm_row> walkFinder(*this);
+	if (!walkFinder.addWalk(&inset[0], walk, currentX, currentY, targetX, y))
 		return false;
 	// We were searching for the finishing position.
 	if (x == getWidth())
-		p.push_back(DIR_EAST);
+		walk.push_back(DIR_EAST);
+	// We were searching for the starting position.
+	else if (x == -1)
+		walk.push_back(DIR_WEST);
+	p.append(walk);
 	return true;
 }
 
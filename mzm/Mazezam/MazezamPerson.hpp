@@ -11,6 +11,7 @@
 #define MAZEZAMPERSON_H_
 
 #include <mzm/Mazezam/MazezamData.hpp>
+#include <mzm/Mazezam/PackedPath.hpp>
 
 namespace mzm {
 
@@ -127,6 +128,11 @@ public:
 	 * \param numSteps follow this many steps, or all the way if numSteps is negative.
 	 */
 	void followPath(const mzm_path& p, int numSteps = -1);
+protected:
+	/*!
+	 * Put the person at a position, without checking how they got there.
+	 */
+	inline void setPosition(mzm_coord y, mzm_coord x);
 private:
 	/*!
 	 * The person's y coordinate.
@@ -51,4 +51,10 @@ bool MazezamPerson::atExit() const
 	return (m_x == getWidth()) && (m_y == getFinish());	
 }
 
+void MazezamPerson::setPosition(mzm_coord y, mzm_coord x)
+{
+	m_y = y;
+	m_x = x;
+}
+
 } // namespace mzm
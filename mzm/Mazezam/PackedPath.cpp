@@ -0,0 +1,51 @@
+/* ***************************************************************************
+ * PackedPath.cpp
+ * Copyright (c) 2008, 2010, 2020 Malcolm Tyrrell.
+ * All rights reserved. This program and the accompanying materials
+ * are made available under the terms of the GNU Public License v3.0
+ * which accompanies this distribution, and is available at
+ * http://gplv3.fsf.org/
+ * ***************************************************************************/
+
+#include <mzm/Mazezam/PackedPath.hpp>
+
+namespace mzm {
+
+PackedPath::PackedPath()
+: m_size(0)
+{
+}
+
+void PackedPath::append(const PackedPath& other)
+{
+	// other may be this path.
+	const unsigned int otherSize = other.m_size;
+	for (unsigned int i = 0; i < otherSize; ++i)
+		push_back(other[i]);
+}
+
+void PackedPath::resize(unsigned int n)
+{
+	m_words.resize((n + MOVES_PER_WORD - 1) / MOVES_PER_WORD, 0);
+	m_size = n;
+	// Clear the moves beyond the end of the last word, since push_back
+	// assumes they are zero.
+	const unsigned int used = n % MOVES_PER_WORD;
+	if (used != 0)
+		m_words.back() &= (1ULL << (used * BITS_PER_MOVE)) - 1;
+}
+
+void PackedPath::clear()
+{
+	m_words.clear();
+	m_size = 0;
+}
+
+std::ostream& operator<< (std::ostream& os, const mzm_path& p)
+{
+	for (mzm_path::const_iterator i = p.begin(); i != p.end(); ++i)
+		os << *i;
+	return os;
+}
+
+} // namespace mzm
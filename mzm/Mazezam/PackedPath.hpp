@@ -0,0 +1,151 @@
+/* ***************************************************************************
+ * PackedPath.hpp
+ * Copyright (c) 2008, 2010, 2020 Malcolm Tyrrell.
+ * All rights reserved. This program and the accompanying materials
+ * are made available under the terms of the GNU Public License v3.0
+ * which accompanies this distribution, and is available at
+ * http://gplv3.fsf.org/
+ * ***************************************************************************/
+
+#ifndef PACKEDPATH_H_
+#define PACKEDPATH_H_
+
+#include <vector>
+#include <iterator>
+#include <ostream>
+#include <cassert>
+
+#include <mzm/Mazezam/TypesAndConstants.hpp>
+
+namespace mzm {
+
+/*!
+ * A sequence of mzm_directions, packed into 3 bits each.
+ * Solutions can run to thousands of moves, and the designer and the solver
+ * keep them for whole packs of levels, so they are kept at a tenth of the size
+ * of a vector of directions. Moves can be appended and read from anywhere in
+ * constant time.
+ */
+class PackedPath
+{
+public:
+	/*!
+	 * A random access iterator through the moves of a path, which reads them by
+	 * value, as a vector<bool>'s does.
+	 */
+	class const_iterator
+	{
+	public:
+		typedef std::random_access_iterator_tag iterator_category;
+		typedef mzm_direction value_type;
+		typedef int difference_type;
+		typedef const mzm_direction* pointer;
+		typedef mzm_direction reference;
+
+		inline const_iterator() : m_path(0), m_index(0) {}
+		inline mzm_direction operator*() const { return (*m_path)[m_index]; }
+		inline mzm_direction operator[](int n) const { return (*m_path)[m_index + n]; }
+		inline const_iterator& operator++() { ++m_index; return *this; }
+		inline const_iterator& operator--() { --m_index; return *this; }
+		inline const_iterator operator++(int) { const_iterator old(*this); ++m_index; return old; }
+		inline const_iterator operator--(int) { const_iterator old(*this); --m_index; return old; }
+		inline const_iterator& operator+=(int n) { m_index += n; return *this; }
+		inline const_iterator& operator-=(int n) { m_index -= n; return *this; }
+		inline const_iterator operator+(int n) const { return const_iterator(m_path, m_index + n); }
+		inline const_iterator operator-(int n) const { return const_iterator(m_path, m_index - n); }
+		inline int operator-(const const_iterator& other) const { return (int) m_index - (int) other.m_index; }
+		inline bool operator==(const const_iterator& other) const { return m_index == other.m_index; }
+		inline bool operator!=(const const_iterator& other) const { return m_index != other.m_index; }
+		inline bool operator<(const const_iterator& other) const { return m_index < other.m_index; }
+		inline bool operator>(const const_iterator& other) const { return m_index > other.m_index; }
+		inline bool operator<=(const const_iterator& other) const { return m_index <= other.m_index; }
+		inline bool operator>=(const const_iterator& other) const { return m_index >= other.m_index; }
+		friend inline const_iterator operator+(int n, const const_iterator& it) { return it + n; }
+	private:
+		friend class PackedPath;
+		inline const_iterator(const PackedPath* path, unsigned int index) : m_path(path), m_index(index) {}
+		/*!
+		 * The path being read.
+		 */
+		const PackedPath* m_path;
+		/*!
+		 * The index of the move the iterator is at.
+		 */
+		unsigned int m_index;
+	};
+
+	/*!
+	 * Constructor for an empty path.
+	 */
+	PackedPath();
+
+	/*!
+	 * The number of moves in the path.
+	 */
+	inline unsigned int size() const;
+	/*!
+	 * Is the path empty?
+	 */
+	inline bool empty() const;
+	/*!
+	 * Get the move at index i.
+	 */
+	inline mzm_direction operator[](unsigned int i) const;
+	/*!
+	 * Set the move at index i, which must be in the path.
+	 */
+	inline void set(unsigned int i, mzm_direction d);
+	/*!
+	 * Add a move to the end of the path.
+	 */
+	inline void push_back(mzm_direction d);
+	/*!
+	 * Add the moves of another path to the end of this one.
+	 */
+	void append(const PackedPath& other);
+	/*!
+	 * Remove moves from the end of the path, or add DIR_NORTHs to it, to give
+	 * it n moves.
+	 */
+	void resize(unsigned int n);
+	/*!
+	 * Remove all the moves.
+	 */
+	void clear();
+
+	inline const_iterator begin() const { return const_iterator(this, 0); }
+	inline const_iterator end() const { return const_iterator(this, m_size); }
+private:
+	/*!
+	 * The number of bits used by each move.
+	 */
+	static const unsigned int BITS_PER_MOVE = 3;
+	/*!
+	 * The number of moves packed into each word. The top bit of a word is unused.
+	 */
+	static const unsigned int MOVES_PER_WORD = 21;
+	/*!
+	 * The moves, in order from the low bits of the first word.
+	 */
+	std::vector<unsigned long long> m_words;
+	/*!
+	 * The number of moves.
+	 */
+	unsigned int m_size;
+};
+
+/*!
+ * Stores a sequence of mzm_directions.
+ */
+typedef PackedPath mzm_path;
+
+/*!
+ * Write a path to an ostream. 
+ */
+std::ostream& operator<< (std::ostream& os, const mzm_path& p);
+
+} // namespace mzm
+
+#include "PackedPath.inl"
+
+#endif /*PACKEDPATH_H_*/
@@ -0,0 +1,45 @@
+/* ***************************************************************************
+ * PackedPath.inl
+ * Copyright (c) 2008, 2010, 2020 Malcolm Tyrrell.
+ * All rights reserved. This program and the accompanying materials
+ * are made available under the terms of the GNU Public License v3.0
+ * which accompanies this distribution, and is available at
+ * http://gplv3.fsf.org/
+ * ***************************************************************************/
+namespace mzm {
+
+unsigned int PackedPath::size() const
+{
+	return m_size;
+}
+
+bool PackedPath::empty() const
+{
+	return m_size == 0;
+}
+
+mzm_direction PackedPath::operator[](unsigned int i) const
+{
+	assert(i < m_size);
+	const unsigned int shift = (i % MOVES_PER_WORD) * BITS_PER_MOVE;
+	return (mzm_direction) ((m_words[i / MOVES_PER_WORD] >> shift) & 7);
+}
+
+void PackedPath::set(unsigned int i, mzm_direction d)
+{
+	assert(i < m_size);
+	const unsigned int shift = (i % MOVES_PER_WORD) * BITS_PER_MOVE;
+	unsigned long long& word = m_words[i / MOVES_PER_WORD];
+	word = (word & ~(7ULL << shift)) | ((unsigned long long) d << shift);
+}
+
+void PackedPath::push_back(mzm_direction d)
+{
+	const unsigned int shift = (m_size % MOVES_PER_WORD) * BITS_PER_MOVE;
+	if (shift == 0)
+		m_words.push_back(0);
+	m_words.back() |= (unsigned long long) d << shift;
+	++m_size;
+}
+
+} // namespace mzm
@@ -0,0 +1,199 @@
+/* ***************************************************************************
+ * SharedLevel.cpp
+ * Copyright (c) 2008, 2010, 2020 Malcolm Tyrrell.
+ * All rights reserved. This program and the accompanying materials
+ * are made available under the terms of the GNU Public License v3.0
+ * which accompanies this distribution, and is available at
+ * http://gplv3.fsf.org/
+ * ***************************************************************************/
+
+#include <mzm/Mazezam/SharedLevel.hpp>
+
+#include <cassert>
+
+namespace mzm {
+
+pthread_mutex_t SharedLevel::s_lock = PTHREAD_MUTEX_INITIALIZER;
+std::multimap<unsigned long long, SharedLevel::Storage*> SharedLevel::s_interned;
+
+SharedLevel::SharedLevel()
+: m_storage(0)
+{
+}
+
+SharedLevel::SharedLevel(const MazezamData& level)
+: m_storage(0)
+{
+	const unsigned long long hash = getHash(level);
+	pthread_mutex_lock(&s_lock);
+	m_storage = findInterned(level, hash);
+	pthread_mutex_unlock(&s_lock);
+	if (m_storage)
+		return;
+
+	// The copy is made without the lock held.
+	Storage* storage = new Storage;
+	try {
+		storage->m_level = new MazezamData(level);
+	} catch (...) {
+		delete storage;
+		throw;
+	}
+	storage->m_references = 1;
+	storage->m_base = 0;
+	storage->m_isInterned = true;
+	storage->m_hash = hash;
+	pthread_mutex_lock(&s_lock);
+	// Another thread may have interned an equal level meanwhile.
+	m_storage = findInterned(level, hash);
+	if (!m_storage) {
+		s_interned.insert(std::make_pair(hash, storage));
+		m_storage = storage;
+	}
+	pthread_mutex_unlock(&s_lock);
+	if (m_storage != storage) {
+		delete storage->m_level;
+		delete storage;
+	}
+}
+
+SharedLevel::SharedLevel(const SharedLevel& base, const std::vector<int>& toggles)
+: m_storage(0)
+{
+	assert(!base.isNull());
+	Storage* storage = new Storage;
+	storage->m_references = 1;
+	storage->m_level = 0;
+	storage->m_base = base.m_storage;
+	storage->m_toggles = toggles;
+	storage->m_isInterned = false;
+	storage->m_hash = 0;
+	addReference(storage->m_base);
+	m_storage = storage;
+}
+
+SharedLevel::SharedLevel(const SharedLevel& other)
+: m_storage(other.m_storage)
+{
+	if (m_storage)
+		addReference(m_storage);
+}
+
+SharedLevel& SharedLevel::operator=(const SharedLevel& other)
+{
+	if (other.m_storage)
+		addReference(other.m_storage);
+	if (m_storage)
+		removeReference(m_storage);
+	m_storage = other.m_storage;
+	return *this;
+}
+
+SharedLevel::~SharedLevel()
+{
+	if (m_storage)
+		removeReference(m_storage);
+}
+
+const MazezamData& SharedLevel::operator*() const
+{
+	assert(m_storage);
+	const MazezamData* level = __atomic_load_n(&m_storage->m_level, __ATOMIC_ACQUIRE);
+	if (level)
+		return *level;
+	pthread_mutex_lock(&s_lock);
+	const MazezamData& materialized = materialize(m_storage);
+	pthread_mutex_unlock(&s_lock);
+	return materialized;
+}
+
+SharedLevel::Storage* SharedLevel::findInterned(const MazezamData& level, unsigned long long hash)
+{
+	typedef std::multimap<unsigned long long, Storage*>::iterator Iterator;
+	const std::pair<Iterator, Iterator> range = s_interned.equal_range(hash);
+	for (Iterator it = range.first; it != range.second; ++it) {
+		if (isEqual(*it->second->m_level, level)) {
+			++it->second->m_references;
+			return it->second;
+		}
+	}
+	return 0;
+}
+
+void SharedLevel::addReference(Storage* storage)
+{
+	pthread_mutex_lock(&s_lock);
+	++storage->m_references;
+	pthread_mutex_unlock(&s_lock);
+}
+
+void SharedLevel::removeReference(Storage* storage)
+{
+	// Deleting a level removes its reference to its base.
+	while (storage) {
+		pthread_mutex_lock(&s_lock);
+		const bool isLast = (--storage->m_references == 0);
+		if (isLast && storage->m_isInterned) {
+			// Once it's out of the table, nothing else can find the level.
+			typedef std::multimap<unsigned long long, Storage*>::iterator Iterator;
+			Iterator it = s_interned.lower_bound(storage->m_hash);
+			while (it->second != storage)
+				++it;
+			s_interned.erase(it);
+		}
+		pthread_mutex_unlock(&s_lock);
+		if (!isLast)
+			return;
+		Storage* base = storage->m_base;
+		delete storage->m_level;
+		delete storage;
+		storage = base;
+	}
+}
+
+const MazezamData& SharedLevel::materialize(Storage* storage)
+{
+	if (!storage->m_level) {
+		MazezamData* level = new MazezamData(materialize(storage->m_base));
+		const int width = level->getWidth();
+		for (std::vector<int>::const_iterator it = storage->m_toggles.begin(); it != storage->m_toggles.end(); ++it) {
+			const mzm_coord y = *it / width;
+			const mzm_coord x = *it % width;
+			level->setBlock(y, x, !level->getBlock(y, x));
+		}
+		// Other threads may look at the level without taking the lock.
+		__atomic_store_n(&storage->m_level, level, __ATOMIC_RELEASE);
+	}
+	return *storage->m_level;
+}
+
+unsigned long long SharedLevel::getHash(const MazezamData& level)
+{
+	// FNV-1a, over the dimensions, then the rows and their insets.
+	const unsigned long long prime = 1099511628211ULL;
+	unsigned long long hash = 14695981039346656037ULL;
+	hash = (hash ^ (unsigned char) level.getHeight()) * prime;
+	hash = (hash ^ (unsigned char) level.getWidth()) * prime;
+	hash = (hash ^ (unsigned char) level.getStart()) * prime;
+	hash = (hash ^ (unsigned char) level.getFinish()) * prime;
+	for (mzm_coord y = 0; y < level.getHeight(); ++y) {
+		const mzm_row row = level.getRow(y);
+		for (unsigned int i = 0; i < sizeof(mzm_row); ++i)
+			hash = (hash ^ (unsigned char) (row >> (8 * i))) * prime;
+		hash = (hash ^ (unsigned char) level.getInset(y)) * prime;
+	}
+	return hash;
+}
+
+bool SharedLevel::isEqual(const MazezamData& a, const MazezamData& b)
+{
+	if ((a.getHeight() != b.getHeight()) || (a.getWidth() != b.getWidth())
+			|| (a.getStart() != b.getStart()) || (a.getFinish() != b.getFinish()))
+		return false;
+	for (mzm_coord y = 0; y < a.getHeight(); ++y)
+		if ((a.getRow(y) != b.getRow(y)) || (a.getInset(y) != b.getInset(y)))
+			return false;
+	return true;
+}
+
+} // namespace mzm
@@ -0,0 +1,147 @@
+/* ***************************************************************************
+ * SharedLevel.hpp
+ * Copyright (c) 2008, 2010, 2020 Malcolm Tyrrell.
+ * All rights reserved. This program and the accompanying materials
+ * are made available under the terms of the GNU Public License v3.0
+ * which accompanies this distribution, and is available at
+ * http://gplv3.fsf.org/
+ * ***************************************************************************/
+
+#ifndef SHAREDLEVEL_H_
+#define SHAREDLEVEL_H_
+
+#include <map>
+#include <vector>
+#include <pthread.h>
+
+#include <mzm/Mazezam/MazezamData.hpp>
+
+namespace mzm {
+
+/*!
+ * A handle to a level which can't be changed, so it can be shared between
+ * the jobs solving it, their solutions and the collectors keeping them,
+ * whichever threads they're on. The level is deleted with its last handle.
+ * Handles made from equal levels share a single copy of them.
+ * A level can also be made from another by toggling a few blocks. It only
+ * keeps the other level and the toggles until its contents are first needed.
+ */
+class SharedLevel
+{
+public:
+	/*!
+	 * Constructor for a handle to no level.
+	 */
+	SharedLevel();
+	/*!
+	 * Constructor for a handle to a level, which shares an equal level if
+	 * there already is one.
+	 * \param level the contents of the level.
+	 */
+	explicit SharedLevel(const MazezamData& level);
+	/*!
+	 * Constructor for a handle to a level made by toggling blocks of another.
+	 * \param base the other level.
+	 * \param toggles the blocks to toggle, numbered row by row.
+	 */
+	SharedLevel(const SharedLevel& base, const std::vector<int>& toggles);
+	/*!
+	 * Copy constructor, which shares the level.
+	 */
+	SharedLevel(const SharedLevel& other);
+	/*!
+	 * Copy assignment, which shares the level.
+	 */
+	SharedLevel& operator=(const SharedLevel& other);
+	/*!
+	 * Destructor.
+	 */
+	~SharedLevel();
+
+	/*!
+	 * Is this a handle to no level?
+	 */
+	inline bool isNull() const { return m_storage == 0; }
+
+	/*!
+	 * Access the level, which must not be null.
+	 */
+	const MazezamData& operator*() const;
+	inline const MazezamData* operator->() const { return &**this; }
+private:
+	/*!
+	 * A level and the handles to it.
+	 */
+	struct Storage {
+		/*!
+		 * The number of handles.
+		 */
+		unsigned int m_references;
+		/*!
+		 * The contents of the level, or NULL if they haven't been made from the base yet.
+		 */
+		MazezamData* m_level;
+		/*!
+		 * The level this one was made from, or NULL.
+		 */
+		Storage* m_base;
+		/*!
+		 * The blocks toggled in the base.
+		 */
+		std::vector<int> m_toggles;
+		/*!
+		 * Is the level in the table of shared levels?
+		 */
+		bool m_isInterned;
+		/*!
+		 * A hash of the level, if it is in the table.
+		 */
+		unsigned long long m_hash;
+	};
+	/*!
+	 * The level, or NULL.
+	 */
+	Storage* m_storage;
+
+	/*!
+	 * Guards the references and the table.
+	 */
+	static pthread_mutex_t s_lock;
+	/*!
+	 * The levels made by the first constructor, by their hash.
+	 */
+	static std::multimap<unsigned long long, Storage*> s_interned;
+
+	/*!
+	 * Add a reference to storage.
+	 */
+	static void addReference(Storage* storage);
+	/*!
+	 * Remove a reference to storage, deleting it if it was the last.
+	 */
+	static void removeReference(Storage* storage);
+	/*!
+	 * Find a level in the table equal to the given one, and add a reference to
+	 * it. s_lock must be held.
+	 * \param level the contents of the level.
+	 * \param hash the hash of the level.
+	 * \return the level's storage, or 0 if there is none.
+	 */
+	static Storage* findInterned(const MazezamData& level, unsigned long long hash);
+	/*!
+	 * Make the contents of storage from its base. s_lock must be held.
+	 */
+	static const MazezamData& materialize(Storage* storage);
+	/*!
+	 * A hash of the contents of a level.
+	 */
+	static unsigned long long getHash(const MazezamData& level);
+	/*!
+	 * Are the contents of two levels equal?
+	 */
+	static bool isEqual(const MazezamData& a, const MazezamData& b);
+};
+
+} // namespace mzm
+
+#endif /*SHAREDLEVEL_H_*/
@@ -17,8 +17,7 @@ const int MAX_MAZEZAM_HEIGHT = 255;
 const int MIN_MAZEZAM_HEIGHT = 2;
 // The number of bits in an mzm_row is the number of chars times the number
 // bits in a char.
-// TODO - work out why I need the "- 1"
-// Currently the solver thinks maximal width mazezams are unsolvable.
+// The top bit of a row is never used (see rowTypeFits), hence the "- 1".
 const int MAX_MAZEZAM_WIDTH = sizeof(mzm_row) * CHAR_BIT - 1;
 const int MIN_MAZEZAM_WIDTH = 4;
 
@@ -28,11 +27,4 @@ std::ostream& operator<< (std::ostream& os, const mzm_direction& d)
 	return os;
 }
 
-std::ostream& operator<< (std::ostream& os, const mzm_path& p)
-{
-	for (mzm_path::const_iterator i = p.begin(); i != p.end(); ++i)
-		os << *i;
-	return os;
-}
-
 } // namespace mzm
\ No newline at end of file
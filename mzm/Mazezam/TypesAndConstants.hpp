@@ -12,6 +12,7 @@
 
 #include<vector>
 #include<ostream>
+#include<climits>
 
 namespace mzm {
 
@@ -22,8 +23,21 @@ typedef signed char mzm_coord;
 /*!
  * Type for a row of level data encoded in binary.
  * We use binary encodings to allow an efficient encoding of the zone in ConfigEqv.
+ * Levels store their rows in the widest type supported, but the solver works
+ * with the narrowest type which can hold the rows of the level it is solving
+ * (see rowTypeFits), so narrow levels are solved as fast as ever.
  */
-typedef unsigned int mzm_row;
+__extension__ typedef unsigned __int128 mzm_row;
+
+/*!
+ * Returns true if rows of a level of the given width fit in the unsigned type R.
+ * As with MAX_MAZEZAM_WIDTH, the top bit of R is never used.
+ */
+template<class R>
+inline bool rowTypeFits(int width)
+{
+	return width < (int) (sizeof(R) * CHAR_BIT);
+}
 
 /*!
  * The maximum height of a mazezam supported by the program.
@@ -35,7 +49,8 @@ extern const int MAX_MAZEZAM_HEIGHT;
 extern const int MIN_MAZEZAM_HEIGHT;
 /*!
  * The maximum width of a mazezam supported by the program.
- * This is defined to be the same size as the number of bits in an mzm_row.
+ * This is one less than the number of bits in an mzm_row, and doesn't count
+ * the walls.
  */
 extern const int MAX_MAZEZAM_WIDTH;
 /*!
@@ -55,12 +70,6 @@ enum mzm_direction {
 	DIR_PUSH_WEST
 };
 
-/*!
- * Stores a sequence of mzm_directions.
- * This never stores the initial or final EAST moves.
- */
-typedef std::vector<mzm_direction> mzm_path;
-
 /*!
  * The characters used to input and output Mazezams.
  */
@@ -82,11 +91,6 @@ static const char directionChars[] = {'u', 'd', 'r', 'l', 'R', 'L'};
  */
 std::ostream& operator<< (std::ostream& os, const mzm_direction& d);
 
-/*!
- * Write a path to an ostream. 
- */
-std::ostream& operator<< (std::ostream& os, const mzm_path& p);
-
 } // namespace mzm
 
 #endif /*MAZEZAM_TYPES_H_*/
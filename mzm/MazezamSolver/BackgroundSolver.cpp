@@ -17,29 +17,32 @@ namespace mzm {
 
 BackgroundSolver::BackgroundSolver(mzmslv::WorkerPool& workerPool, SolutionCollector& collector) 
 : MultiMazezamSolver(workerPool, collector)
-, m_level(NULL)
 {
 }
 
 BackgroundSolver::~BackgroundSolver()
 {
-	if (m_level != NULL) {
+	if (!m_level.isNull())
 		m_workerPool.releaseAsynchronous();
-		delete m_level;
-	}
 }
 
 mzmslv::WorkerPoolJob* BackgroundSolver::getNextJob()
 {
 	//assert(!(m_outstandingFlags & ~m_solutionTypeFlags));
 
-	mzmslv::WorkerPoolJob* job = NULL;
+	Batch* job = NULL;
 	
 	if (m_outstandingFlags) {
+		// Each search gets a batch of its own, so they can be done at the same time.
 		MazezamSolutionType type = extractNextSolutionType(m_outstandingFlags);
-		job = createMazezamSolverJob(*m_level, type);
-		WorkUnderway underway = { 0, type }; 
-		m_currentWork[job] = underway;
+		job = new Batch;
+		job->addJob(m_level, 0, type, isBoundingMoves(type));
+		// The rating is what the designer shows first. Finding the fewest moves
+		// is slow and can wait.
+		if (type == MAZEZAM_SOLUTION_FEWEST_PUSHES)
+			job->setPriority(mzmslv::WorkerPoolJob::PRIORITY_HIGH);
+		else if (type == MAZEZAM_SOLUTION_FEWEST_MOVES)
+			job->setPriority(mzmslv::WorkerPoolJob::PRIORITY_LOW);
 	}
 	
 	return job;
@@ -48,13 +51,11 @@ mzmslv::WorkerPoolJob* BackgroundSolver::getNextJob()
 
 void BackgroundSolver::setNewLevel(const MazezamData& l, unsigned int solutionFlags)
 {
-	if (m_level != NULL) {
+	if (!m_level.isNull())
 		m_workerPool.releaseAsynchronous();
-		delete m_level;
-	}
 	m_solutionTypeFlags = solutionFlags;
 	m_outstandingFlags = getSearches(m_solutionTypeFlags);
-	m_level = new MazezamData(l);
+	m_level = SharedLevel(l);
 	m_workerPool.workAsynchronous(this);
 }
 
@@ -38,9 +38,9 @@ public:
 	
 private:
 	/*!
-	 * The level being solved.
+	 * The level being solved, or null before the first level is set.
 	 */
-	MazezamData* m_level; 
+	SharedLevel m_level;
 };
 
 } // namespace mzm
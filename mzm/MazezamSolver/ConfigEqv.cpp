@@ -10,168 +10,152 @@
 #include <cassert>
 
 #include <mzm/MazezamSolver/ConfigEqv.hpp>
-#include <mzmslv/Solver.hpp>
-#include <mzm/MazezamSolver/ConfigWalk.hpp>
+#include <mzm/MazezamSolver/InsetStore.hpp>
+#include <mzmslv/MemoryAccount.hpp>
 
 namespace mzm {
 
-ConfigEqv::ConfigEqv(const MazezamData& m) :
+template<class R>
+ConfigEqv<R>::ConfigEqv(const MazezamData& m) :
 	m_level(m)
 {
 	assert (m.isValid());
 	assert (m_level.getStart() < m_level.getHeight());
 	assert (m_level.getFinish() < m_level.getHeight());
 	
-	m_inset = new mzm_coord[m_level.getHeight()];
-	try {
-		m_zone = new mzm_row[m_level.getHeight()];
-		try { // buildZone is recursive, so it may cause an exception.
-			for (int i = 0; i < m_level.getHeight(); ++i) {
-				m_inset[i] = m_level.getInset(i);
-				m_zone[i] = 0;
-			}
-			buildZone(1 << (m_level.getWidth() - 1), m_level.getStart());
-		} catch (...) {
-			delete[] m_zone;
-			throw;
-		}
-	} catch (...) {
-		delete[] m_inset;
-		throw;
-	}
-}
-	
-ConfigEqv::ConfigEqv(const MazezamData& l, const mzm_coord* inset, int xxx, mzm_coord y) :
-	m_level(l)
-{
-	assert (y < m_level.getHeight());
-	assert (xxx < (1 << m_level.getWidth()));
-	assert(l.checkInsets(m_inset));
-	assert (!(row(y) & xxx));
-	
-	m_inset = new mzm_coord[m_level.getHeight()];
-	try {
-		m_zone = new mzm_row[m_level.getHeight()];
-		try { // buildZone is recursive, so it may cause an exception.
-			for (int i = 0; i < m_level.getHeight(); ++i) {
-				m_inset[i] = inset[i];
-				m_zone[i] = 0;
-			}
-			buildZone(xxx, y);
-		} catch (...) {
-			delete[] m_zone;
-			throw;
-		}
-	} catch (...) {
-		delete[] m_inset;
-		throw;
-	}
+	m_store = new InsetStore<R>(m_level);
+	m_store->addReference();
+	std::vector<mzm_coord> inset(m_level.getHeight());
+	for (int i = 0; i < m_level.getHeight(); ++i)
+		inset[i] = m_level.getInset(i);
+	m_insetsId = m_store->intern(&inset[0]);
+	setZone((R) 1 << (m_level.getWidth() - 1), m_level.getStart());
 }
 
-ConfigEqv::ConfigEqv(const MazezamData& l, const mzm_coord* inset, mzm_row xxx, mzm_coord y, bool wasLeft) :
-	m_level(l)
+template<class R>
+ConfigEqv<R>::ConfigEqv(const ConfigEqv& parent, const R* parentZone, R xxx, mzm_coord y, bool wasLeft) :
+	m_level(parent.m_level), m_store(parent.m_store)
 {
 	assert (y < m_level.getHeight());
-	assert (xxx < (mzm_row) (1 << m_level.getWidth()));
-	assert (l.checkInsets(inset));
+	assert (xxx < ((R) 1 << m_level.getWidth()));
+	assert (m_level.checkInsets(parent.getInsets()));
 	// the player should be standing on a block.
-	assert ((m_level.getRow(y) >> inset[y]) & xxx);
+	assert (row(parent.getInsets(), y) & xxx);
 	// If the push was to the right, then there should be a space on the left of the player.
-	assert (wasLeft || !((m_level.getRow(y) >> inset[y]) & (xxx << 1)));
+	assert (wasLeft || !(row(parent.getInsets(), y) & (xxx << 1)));
 	// If the push was to the left, then there should be a space on the right of the player.
-	assert (!wasLeft || !((m_level.getRow(y) >> inset[y]) & (xxx >> 1)));
+	assert (!wasLeft || !(row(parent.getInsets(), y) & (xxx >> 1)));
 	
-	m_inset = new mzm_coord[m_level.getHeight()];
-	try {
-		m_zone = new mzm_row[m_level.getHeight()];
-		try { // buildZone is recursive, so it may cause an exception.
-			for (int i = 0; i < m_level.getHeight(); ++i) {
-				m_inset[i] = inset[i];
-				m_zone[i] = 0;
-			}
-			if (wasLeft)
-				--m_inset[y];
-			else
-				++m_inset[y];
-			buildZone(xxx, y);
-		} catch (...) {
-			delete[] m_zone;
-			throw;
-		}
-	} catch (...) {
-		delete[] m_inset;
-		throw;
-	}
+	m_store->addReference();
+	m_insetsId = m_store->internPush(parent.m_insetsId, y, wasLeft);
+	updateZone(parentZone, xxx, y, wasLeft);
+}
+
+template<class R>
+ConfigEqv<R>::~ConfigEqv()
+{
+	m_store->removeReference();
+}
+
+template<class R>
+void* ConfigEqv<R>::operator new(std::size_t size)
+{
+	return mzmslv::MemoryAccount::allocate(mzmslv::SolverStats::KIND_CONFIGURATIONS, size);
 }
 
-ConfigEqv::~ConfigEqv()
+template<class R>
+void ConfigEqv<R>::operator delete(void* config, std::size_t size)
 {
-	delete[] m_inset;
-	delete[] m_zone;
+	mzmslv::MemoryAccount::deallocate(mzmslv::SolverStats::KIND_CONFIGURATIONS, config, size);
 }
 
+template<class R>
+const mzm_coord* ConfigEqv<R>::getInsets() const
+{
+	return m_store->getInsets(m_insetsId);
+}
 
-void ConfigEqv::buildZone(int xxx, mzm_coord y)
+template<class R>
+mzm_hash ConfigEqv<R>::getHash() const
+{
+	return m_store->getHash(m_insetsId) ^ Zobrist::getComponentKey(m_component);
+}
+
+template<class R>
+void ConfigEqv<R>::setZone(R xxx, mzm_coord y)
 {
 	// check there's no block in the way
-	assert (!(row(y) & xxx));
-	if (!(m_zone[y] & xxx)) {
-		// add x,y
-		m_zone[y] |= xxx;
-		// try north
-		if ((y > 0) && !(row(y-1) & xxx))
-			buildZone(xxx,y-1);
-		// try south
-		if ((y < m_level.getHeight()-1) && !(row(y+1) & xxx))
-			buildZone(xxx,y+1);
-		// try east
-		if ((xxx > 1) && !(row(y) & (xxx >> 1)))
-			buildZone(xxx >> 1,y);
-		// try west
-		if ((xxx < (1 << (m_level.getWidth()-1))) && !(row(y) & (xxx << 1)))
-			buildZone(xxx << 1,y);
+	assert (!(row(getInsets(), y) & xxx));
+	const ZoneLabelling<R>& labelling = m_store->getLabelling(m_insetsId);
+	const unsigned int component = labelling.getComponent(xxx, y);
+	assert (component != ZoneLabelling<R>::NO_COMPONENT);
+	m_component = component;
+	m_isGoal = (component == labelling.getGoalComponent());
+}
+
+template<class R>
+void ConfigEqv<R>::updateZone(const R* parentZone, R xxx, mzm_coord y, bool wasLeft)
+{
+	const int height = m_level.getHeight();
+	const mzm_coord* inset = getInsets();
+	const R full = ((R) 1 << m_level.getWidth()) - 1;
+	R* zone = &m_store->getPushScratch()[0];
+	R* space = zone + height;
+	for (int i = 0; i < height; ++i)
+		space[i] = ~row(inset, i) & full;
+	// Only when the push may have split the zone are the insets labelled, or
+	// their labelling found in the cache.
+	if (!ZoneLabelling<R>::updateZone(zone, parentZone, space, height, xxx, y, wasLeft)) {
+		setZone(xxx, y);
+		return;
 	}
+	m_component = ZoneLabelling<R>::getComponentNumber(zone);
+	m_isGoal = (zone[m_level.getFinish()] & 1) != 0;
+	assert (m_component == m_store->getLabelling(m_insetsId).getComponent(xxx, y));
+	assert (m_isGoal == (m_component == m_store->getLabelling(m_insetsId).getGoalComponent()));
 }
 
+template<class R>
+R ConfigEqv<R>::getZoneRow(mzm_coord y) const
+{
+	return m_store->getLabelling(m_insetsId).getZoneRow(m_component, y);
+}
 
-bool ConfigEqv::operator< (const ConfigEqv& other) const
+template<class R>
+void ConfigEqv<R>::getZone(R* zone) const
 {
-	// This isn't quite strong enough.
-	//assert (m_level == other.m_level);
-	for (int i = 0; i < m_level.getHeight(); ++i) {
-		if (m_inset[i] != other.m_inset[i])
-			return m_inset[i] < other.m_inset[i];
-		if (m_zone[i] != other.m_zone[i])
-			return m_zone[i] < other.m_zone[i];
-	}
-	// they're equal
-	return false;
+	m_store->getLabelling(m_insetsId).getZone(m_component, zone);
 }
 
 
-void ConfigEqv::getNeighbours(std::vector<ConfigEqv*>& v) const {
-	mzm_row pushes;
+template<class R>
+void ConfigEqv<R>::getNeighbours(std::vector<ConfigEqv*>& v) const {
+	// The zone is copied, as building the neighbours can evict its labelling.
+	R* zone = &m_store->getZoneScratch()[0];
+	getZone(zone);
+	const mzm_coord* inset = getInsets();
+	R pushes;
 	for (int i = 0; i < m_level.getHeight(); ++i) {
 		// Opportunities to push right
-		if (!(row(i) & 1)) {
-			pushes = row(i) & (m_zone[i] >> 1);
+		if (!(row(inset, i) & 1)) {
+			pushes = row(inset, i) & (zone[i] >> 1);
 			// handle pushes on this row
-			mzm_row xxx = 1;
+			R xxx = 1;
 			while (pushes > 0) {
 				if (pushes & 1)
-					v.push_back(new ConfigEqv(m_level,m_inset,xxx,i,false));
+					v.push_back(new ConfigEqv(*this,zone,xxx,i,false));
 				pushes >>= 1;
 				xxx <<= 1;
 			}
 		}
 		// Opportunities to push left
-		if (m_inset[i] > 0) {
-			pushes = row(i) & (m_zone[i] << 1);
+		if (inset[i] > 0) {
+			pushes = row(inset, i) & (zone[i] << 1);
 			// handle pushes on this row
-			mzm_row xxx = 1;
+			R xxx = 1;
 			while (pushes > 0) {
 				if (pushes & 1)
-					v.push_back(new ConfigEqv(m_level,m_inset,xxx,i,true));
+					v.push_back(new ConfigEqv(*this,zone,xxx,i,true));
 				pushes >>= 1;
 				xxx <<= 1;
 			}
@@ -179,113 +163,55 @@ void ConfigEqv::getNeighbours(std::vector<ConfigEqv*>& v) const {
 	}
 }
 
-void ConfigEqv::findPush(ConfigEqv& other, mzm_coord& x, mzm_coord& y, bool& isLeft) const
+template<class R>
+bool ConfigEqv<R>::findPush(const ConfigEqv& other, mzm_coord& x, mzm_coord& y, bool& isLeft) const
 {
+	const mzm_coord* inset = getInsets();
+	const mzm_coord* otherInset = other.getInsets();
 	// find y
 	y = 0;
-	while ((y < m_level.getHeight()) && (m_inset[y] == other.m_inset[y])) ++y;
+	while ((y < m_level.getHeight()) && (inset[y] == otherInset[y])) ++y;
 	if (y == m_level.getHeight()) throw NoSuchMoves();
+	const R zone = getZoneRow(y);
+	const R otherZone = other.getZoneRow(y);
 	// find x
-	mzm_row pushes;
-	if (m_inset[y] + 1 == other.m_inset[y]) {
+	R pushes;
+	if (inset[y] + 1 == otherInset[y]) {
 		// The push was right
-		assert (!(row(y) & 1));
+		assert (!(row(inset, y) & 1));
 		isLeft = false;
-		pushes = row(y) & (m_zone[y] >> 1);
+		pushes = row(inset, y) & (zone >> 1);
 		x = m_level.getWidth() - 1;
 		while (pushes > 0) {
 			// x the result of a push right and (x,y) is in other's zone
-			if ((pushes & 1) && (other.m_zone[y] & (1 << (m_level.getWidth() - x - 1)))) {
+			if ((pushes & 1) && (otherZone & ((R) 1 << (m_level.getWidth() - x - 1)))) {
 				--x;
-				return;
+				return true;
 			}
 			pushes >>= 1;
 			--x;
 		}
-	} else if (m_inset[y] - 1 == other.m_inset[y]) {
+	} else if (inset[y] - 1 == otherInset[y]) {
 		// the push was left
-		assert (m_inset[y] > 0);
+		assert (inset[y] > 0);
 		isLeft = true;
-		pushes = row(y) & (m_zone[y] << 1);
+		pushes = row(inset, y) & (zone << 1);
 		x = m_level.getWidth() - 1;
 		while (pushes > 0) {
 			// x the result of a push left and (x,y) is in other's zone
-			if ((pushes & 1) && (other.m_zone[y] & (1 << (m_level.getWidth() - x - 1)))) {
+			if ((pushes & 1) && (otherZone & ((R) 1 << (m_level.getWidth() - x - 1)))) {
 				++x;
-				return;
+				return true;
 			}
 			pushes >>= 1;
 			--x;
 		}
-	} else
-		throw NoSuchMoves();
-}
-
-void ConfigEqv::addInitialMoves(mzm_path& p, mzm_coord& x, mzm_coord& y) const
-{
-	p.push_back(DIR_EAST);
-  	x = 0;
-  	y = m_level.getStart();
-}
-
-void ConfigEqv::addMoves(ConfigEqv& other, mzm_path& p, mzm_coord& x, mzm_coord& y) const
-{
-	// the target x and y coordinates.
-	mzm_coord tx, ty;
-	bool isLeft;
-	findPush(other,tx,ty,isLeft);
-	// We use a breadth-first search to find the shortest way of walking to the target.
-	mzmslv::Solver<ConfigWalk> s;
-	mzmslv::Solver<ConfigWalk>::path cp;
-	MazezamData m(m_level, m_inset);
-	ConfigWalk* init = new ConfigWalk(m, x, y, tx, ty);
-	mzmslv::SolverResult b = s.findSolutionBreadthFirst(init, cp);
-	if (b == mzmslv::FOUND_SOLUTION) {
-		// add the moves corresponding to the walk.
-		for(unsigned int i = 0; i < cp.size() - 1; ++i)
-			cp[i]->addMoves(*cp[i+1],p,x,y);
-		// add an additional move corresponding to the push.
-		if (isLeft) {
-			p.push_back(DIR_PUSH_WEST);
-			--x;
-		}
-		else {
-			p.push_back(DIR_PUSH_EAST);
-			++x;
-		}
 	}
-	// delete the configurations in the solution path.
-	for (mzmslv::Solver<ConfigWalk>::path::iterator i = cp.begin(); i != cp.end(); ++i)
-		delete *i;
-	// It is an error if we cannot find such a walk.
-	if (b != mzmslv::FOUND_SOLUTION)
-		throw NoSuchMoves();
+	throw NoSuchMoves();
 }
 
-
-void ConfigEqv::addFinalMoves(mzm_path& p, mzm_coord& x, mzm_coord& y) const
-{
-	// We use a breadth-first search to find the shortest way of walking to the target.
-	mzmslv::Solver<ConfigWalk> s;
-	mzmslv::Solver<ConfigWalk>::path cp;
-	MazezamData m(m_level, m_inset);
-	ConfigWalk* init = new ConfigWalk(m, x, y, m_level.getWidth() - 1, m_level.getFinish());
-	mzmslv::SolverResult b = s.findSolutionBreadthFirst(init, cp);
-	if (b == mzmslv::FOUND_SOLUTION) {
-		// add the moves corresponding to the walk.
-		for(unsigned int i = 0; i < cp.size() - 1; ++i)
-			cp[i]->addMoves(*cp[i+1],p,x,y);
-	}
-	// delete the configurations in the solution path.
-	for (mzmslv::Solver<ConfigWalk>::path::iterator i = cp.begin(); i != cp.end(); ++i)
-		delete *i;
-	// It is an error if we cannot find such a walk.
-	if (b != mzmslv::FOUND_SOLUTION)
-		throw NoSuchMoves();
-	p.push_back(DIR_EAST);
-}
-
-float ConfigEqv::getEstimatedDistance () const
+template<class R>
+float ConfigEqv<R>::getEstimatedDistance () const
 {
 	if (isGoal()) 
 		return 0.0;
@@ -302,4 +228,8 @@ float ConfigEqv::getEstimatedDistance () const
 //	return c;
 }
 
+template class ConfigEqv<unsigned int>;
+template class ConfigEqv<unsigned long long>;
+template class ConfigEqv<mzm_row>;
+
 } // namespace mzm
\ No newline at end of file
@@ -10,10 +10,15 @@
 #ifndef CONFIGEQV_H_
 #define CONFIGEQV_H_
 
+#include <cassert>
+
 #include <mzm/Mazezam/MazezamData.hpp>
+#include <mzm/MazezamSolver/Zobrist.hpp>
 
 namespace mzm {
 
+template<class R> class InsetStore;
+
 /*!
  * A Solver configuration representing a MazezaM level used to find solutions
  * with the fewest pushes.
@@ -21,7 +26,13 @@ namespace mzm {
  * all reachable position.
  * By significantly reducing the search space, this tends to offer faster
  * solutions than Mazezam.
+ * The insets of the configurations of a search are stored once for each
+ * distinct set of them, and their zones are labelled once for each set and
+ * shared, so each configuration is just a pair of numbers: that of its insets
+ * and that of its zone.
+ * Rows are handled as type R, which must be able to hold the rows of the level.
  */
+template<class R>
 class ConfigEqv
 {
 public:
@@ -35,6 +46,12 @@ public:
 	 * Destructor.
 	 */
 	~ConfigEqv();
+	
+	/*!
+	 * Configurations are accounted for in the memory used by searches.
+	 */
+	static void* operator new(std::size_t size);
+	static void operator delete(void* config, std::size_t size);
 		
 	/*!
 	 * Returns the configurations which can be reached by a single push from the given
@@ -52,6 +69,20 @@ public:
 	 */
 	float getEstimatedDistance () const;
 	
+	/*!
+	 * The cost of the step which reached the configuration. Every step is a push.
+	 */
+	inline unsigned int getCost() const {
+		return 1;
+	}
+
+	/*!
+	 * The cost of the step by which ties are broken. There are none to break.
+	 */
+	inline unsigned int getTieCost() const {
+		return 0;
+	}
+	
 	/*!
 	 * Returns true if the rightmost position on the given row is contained
 	 * in the zone of the given configuration.
@@ -59,52 +90,44 @@ public:
 	 * in the zone of the given configuration.
 	 */
 	inline bool isGoal() const { 
-		return m_zone[m_level.getFinish()] & 1;
+		return m_isGoal;
 	}
 	
 	/*!
-	 * Compare by contents.
-	 * \param other the other Configuration.
+	 * Returns a Zobrist hash of the configuration.
 	 */
-	bool operator< (const ConfigEqv& other) const;
+	mzm_hash getHash() const;
 	
 	/*!
-	 * Exception class thrown by addMoves if the other configuration cannot be reached.
+	 * Compare by contents, which just means comparing the numbers of the insets
+	 * and the zone.
+	 * \param other the other Configuration.
 	 */
-	class NoSuchMoves {};
+	inline bool operator< (const ConfigEqv& other) const {
+		// This isn't quite strong enough.
+		//assert (m_level == other.m_level);
+		assert (m_store == other.m_store);
+		if (m_insetsId != other.m_insetsId)
+			return m_insetsId < other.m_insetsId;
+		return m_component < other.m_component;
+	}
 	
 	/*!
-	 * Add the necessary moves to get from a starting state to this one.
-	 * \throw NoSuchMoves if the other configuration cannot be reached.
-	 * \param p the path to which moves are added.
-	 * \param x the x coord which was reached.
-	 * \param y the y coord which was reached.
+	 * Exception class thrown by findPush if the other configuration cannot be reached.
 	 */
-	void addInitialMoves(mzm_path& p, mzm_coord& x, mzm_coord& y) const;
+	class NoSuchMoves {};
 	
 	/*!
-	 * Add the necessary moves to get from this configuration to other.
-	 * \throw NoSuchMoves if the other configuration cannot be reached.
+	 * Find the push which reaches other from this configuration. Every step of
+	 * the search is a push.
+	 * \throw NoSuchMoves if other cannot be reached by a push.
 	 * \param other the configuration to reach.
-	 * \param p the path to which moves are added.
-	 * \param x the x coord at which to start, and the x coord which was reached.
-	 * \param y the y coord at which to start, and the y coord which was reached.
-	 */
-	void addMoves(ConfigEqv& other, mzm_path& p, mzm_coord& x, mzm_coord& y) const; 
-	
-	/*!
-	 * Add the necessary moves to get from the last configuration to a winning state.
-	 * \throw NoSuchMoves if the winning state cannot be reached.
-	 * \param p the path to which moves are added.
-	 * \param x the x coord at which to start, and the y coord which was reached.
-	 * \param y the y coord at which to start, and the x coord which was reached.
-	 */
-	void addFinalMoves(mzm_path& p, mzm_coord& x, mzm_coord& y) const;
-	
-	/*!
-	 * Write a textual version of a level to an output stream.
+	 * \param x a reference in which the x coord from which the push is made is placed.
+	 * \param y a reference in which the y coord from which the push is made is placed.
+	 * \param isLeft a reference in which the direction is placed.
+	 * \return true.
 	 */
-	friend std::ostream& operator<< (std::ostream& os, ConfigEqv& c);
+	bool findPush(const ConfigEqv& other, mzm_coord& x, mzm_coord& y, bool& isLeft) const;
 public:
 	/*!
 	 * The underlying level.
@@ -112,41 +135,71 @@ public:
 	const MazezamData& m_level;
 protected:
 	/*!
-	 * The amount each row has been pushed rightwards.
+	 * The insets and zones of this search.
 	 */
-	mzm_coord* m_inset;
+	InsetStore<R>* m_store;
 	
 	/*!
-	 * The positions currently reachable by the player.
+	 * The number of the insets (the amount each row has been pushed rightwards)
+	 * in the store.
 	 */
-	mzm_row* m_zone;
+	unsigned int m_insetsId;
+	
+	/*!
+	 * The number of the component of the labelling of the insets which is
+	 * currently reachable by the player.
+	 */
+	unsigned int m_component : 31;
+	
+	/*!
+	 * Whether the zone contains the goal. It shares a word with the component,
+	 * which keeps configurations to 24 bytes.
+	 */
+	unsigned int m_isGoal : 1;
 protected:
+	/*!
+	 * The amount each row has been pushed rightwards.
+	 */
+	const mzm_coord* getInsets() const;
+
 	/*!
 	 * The state of the yth row.
+	 * \param inset the insets.
 	 * \param y the row.
 	 * \return the state of the yth row.
 	 */
-	inline mzm_row row(mzm_coord y) const {
-		return m_level.getRow(y) >> m_inset[y];
+	inline R row(const mzm_coord* inset, mzm_coord y) const {
+		return m_store->getRow(y) >> inset[y];
 	}
 
 	/*!
-	 * Extend the zone with all nodes reachable from (x,y) and modify
-	 * priority.
+	 * Set the zone to the one containing (x,y), which must be clear.
 	 * \param xxx the players current x position, represented in the form (1 << x).
 	 * \param y the row 
 	 */
-	void buildZone(int xxx, mzm_coord y);
+	void setZone(R xxx, mzm_coord y);
 
 	/*!
-	 * Find the x and y coord at which a push in direction will reach other.
-	 * \param other the other MazezamEqv.
-	 * \param x a reference in which the x value is placed.
-	 * \param y a reference in which the y value is placed.
-	 * \param isLeft a reference in which the direction is placed.
+	 * Set the zone after a push from the zone before it, where that's cheap, and
+	 * otherwise from the labelling of the insets, as setZone does.
+	 * \param parentZone the zone before the push.
+	 * \param xxx the players current x position, represented in the form (1 << x).
+	 * \param y the row which was pushed.
+	 * \param wasLeft if the push was left or right.
 	 */
-	void findPush(ConfigEqv& other, mzm_coord& x, mzm_coord& y, bool& isLeft) const;
-	
+	void updateZone(const R* parentZone, R xxx, mzm_coord y, bool wasLeft);
+
+	/*!
+	 * The yth row of the zone.
+	 */
+	R getZoneRow(mzm_coord y) const;
+
+	/*!
+	 * Copy the rows of the zone.
+	 * \param zone where to copy them, which must have a row for each row of the level.
+	 */
+	void getZone(R* zone) const;
+
 	/*!
 	 * Assignment private and unimplemented.
 	 */
@@ -157,24 +210,15 @@ protected:
 	 */
 	ConfigEqv(const ConfigEqv& m);
 	
-	/*!
-	 * Private constructor.
-	 * \param l the underlying level.
-	 * \param inset the insets.
-	 * \param xxx the players current x position, represented in the form (1 << x).
-	 * \param y the players current y position.
-	 */
-	ConfigEqv(const MazezamData& l, const mzm_coord* inset, int xxx, mzm_coord y);
-
 	/*!
 	 * Private constructor constructs the configuration after a push.
-	 * \param l the underlying level.
-	 * \param inset the state of the insets prior to the push.
+	 * \param parent the configuration prior to the push.
+	 * \param parentZone the zone of parent.
 	 * \param xxx the players current x position, represented in the form (1 << x).
 	 * \param y the players current y position.
 	 * \param wasLeft if the push that got the player to (x,y) was left or right
 	 */
-	ConfigEqv(const MazezamData& l, const mzm_coord* inset, mzm_row xxx, mzm_coord y, bool wasLeft);
+	ConfigEqv(const ConfigEqv& parent, const R* parentZone, R xxx, mzm_coord y, bool wasLeft);
 };
 
 } // namespace mzm
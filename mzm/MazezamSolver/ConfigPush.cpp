@@ -0,0 +1,194 @@
+/* ***************************************************************************
+ * ConfigPush.cpp
+ * Copyright (c) 2008, 2010, 2020 Malcolm Tyrrell.
+ * All rights reserved. This program and the accompanying materials
+ * are made available under the terms of the GNU Public License v3.0
+ * which accompanies this distribution, and is available at
+ * http://gplv3.fsf.org/
+ * ***************************************************************************/
+
+#include <cassert>
+
+#include <mzm/MazezamSolver/ConfigPush.hpp>
+#include <mzm/MazezamSolver/InsetStore.hpp>
+#include <mzmslv/MemoryAccount.hpp>
+
+namespace mzm {
+
+template<class R, bool P>
+ConfigPush<R, P>::ConfigPush(const MazezamData& m) :
+	m_level(m), m_moves(0), m_xx(m.getWidth() - 1), m_y(m.getStart())
+{
+	startSearch(NULL);
+}
+
+template<class R, bool P>
+ConfigPush<R, P>::ConfigPush(const MazezamData& m, const std::vector<mzm_coord>& corridor) :
+	m_level(m), m_moves(0), m_xx(m.getWidth() - 1), m_y(m.getStart())
+{
+	startSearch(&corridor);
+}
+
+template<class R, bool P>
+void ConfigPush<R, P>::startSearch(const std::vector<mzm_coord>* corridor)
+{
+	assert (m_level.isValid());
+	m_store = new InsetStore<R>(m_level);
+	m_store->addReference();
+	if (corridor)
+		m_store->restrictTo(*corridor);
+	std::vector<mzm_coord> inset(m_level.getHeight());
+	for (int i = 0; i < m_level.getHeight(); ++i)
+		inset[i] = m_level.getInset(i);
+	m_insetsId = m_store->intern(&inset[0]);
+	assert (m_insetsId != InsetStore<R>::NO_INSETS);
+}
+
+template<class R, bool P>
+ConfigPush<R, P>::ConfigPush(const ConfigPush& parent, unsigned int insetsId, mzm_coord xx, mzm_coord y, unsigned int moves) :
+	m_level(parent.m_level), m_store(parent.m_store), m_insetsId(insetsId), m_moves(moves), m_xx(xx), m_y(y)
+{
+	assert (xx < m_level.getWidth());
+	assert (y < m_level.getHeight());
+	// there should be no block under the player.
+	assert (!(row(getInsets(), y) & ((R) 1 << xx)));
+	m_store->addReference();
+}
+
+template<class R, bool P>
+ConfigPush<R, P>::~ConfigPush()
+{
+	m_store->removeReference();
+}
+
+template<class R, bool P>
+void* ConfigPush<R, P>::operator new(std::size_t size)
+{
+	return mzmslv::MemoryAccount::allocate(mzmslv::SolverStats::KIND_CONFIGURATIONS, size);
+}
+
+template<class R, bool P>
+void ConfigPush<R, P>::operator delete(void* config, std::size_t size)
+{
+	mzmslv::MemoryAccount::deallocate(mzmslv::SolverStats::KIND_CONFIGURATIONS, config, size);
+}
+
+template<class R, bool P>
+const mzm_coord* ConfigPush<R, P>::getInsets() const
+{
+	return m_store->getInsets(m_insetsId);
+}
+
+template<class R, bool P>
+R ConfigPush<R, P>::row(const mzm_coord* inset, mzm_coord y) const
+{
+	return m_store->getRow(y) >> inset[y];
+}
+
+template<class R, bool P>
+mzm_hash ConfigPush<R, P>::getHash() const
+{
+	return m_store->getHash(m_insetsId) ^ Zobrist::getPositionKey(m_xx, m_y);
+}
+
+template<class R, bool P>
+void ConfigPush<R, P>::getNeighbours(std::vector<ConfigPush*>& v) const
+{
+	assert (!isGoal());
+	const int height = m_level.getHeight();
+	const mzm_coord finish = m_level.getFinish();
+	const R full = ((R) 1 << m_level.getWidth()) - 1;
+	const mzm_coord* inset = getInsets();
+	// The walk is searched for in the same way as by WalkFinder, but without
+	// keeping the layers, as only their lengths are needed.
+	R* space = &m_store->getWalkScratch()[0];
+	R* reached = space + height;
+	R* layer = reached + height;
+	R* next = layer + height;
+	for (int i = 0; i < height; ++i) {
+		space[i] = ~row(inset, i) & full;
+		layer[i] = 0;
+	}
+	layer[m_y] = (R) 1 << m_xx;
+	for (int i = 0; i < height; ++i)
+		reached[i] = layer[i];
+
+	// Spread out a step at a time, making the pushes from each position reached.
+	for (unsigned int steps = 0; ; ++steps) {
+		// Any other step from here would take more moves and pushes than walking out.
+		if (layer[finish] & 1) {
+			v.push_back(new ConfigPush(*this, m_insetsId, 0, finish, steps));
+			return;
+		}
+		bool spread = false;
+		for (int i = 0; i < height; ++i) {
+			if (layer[i])
+				addPushes(v, layer[i], i, steps + 1);
+			R r = layer[i] | (layer[i] << 1) | (layer[i] >> 1);
+			if (i > 0)
+				r |= layer[i - 1];
+			if (i < height - 1)
+				r |= layer[i + 1];
+			next[i] = r & space[i] & ~reached[i];
+			spread |= (next[i] != 0);
+		}
+		if (!spread)
+			return;
+		for (int i = 0; i < height; ++i) {
+			reached[i] |= next[i];
+			layer[i] = next[i];
+		}
+	}
+}
+
+template<class R, bool P>
+void ConfigPush<R, P>::addPushes(std::vector<ConfigPush*>& v, R layer, mzm_coord y, unsigned int moves) const
+{
+	const mzm_coord* inset = getInsets();
+	const R r = row(inset, y);
+	// Opportunities to push east, which put the player where the block was.
+	// The insets after a push are the same wherever it's made from, and are
+	// only interned if it can be made.
+	if (!(r & 1)) {
+		R pushes = r & (layer >> 1);
+		if (pushes) {
+			const unsigned int insetsId = m_store->internPush(m_insetsId, y, false);
+			for (mzm_coord xx = 0; (pushes > 0) && (insetsId != InsetStore<R>::NO_INSETS); ++xx, pushes >>= 1)
+				if (pushes & 1)
+					v.push_back(new ConfigPush(*this, insetsId, xx, y, moves));
+		}
+	}
+	// Opportunities to push west.
+	if (inset[y] > 0) {
+		R pushes = r & (layer << 1);
+		if (pushes) {
+			const unsigned int insetsId = m_store->internPush(m_insetsId, y, true);
+			for (mzm_coord xx = 0; (pushes > 0) && (insetsId != InsetStore<R>::NO_INSETS); ++xx, pushes >>= 1)
+				if (pushes & 1)
+					v.push_back(new ConfigPush(*this, insetsId, xx, y, moves));
+		}
+	}
+}
+
+template<class R, bool P>
+bool ConfigPush<R, P>::findPush(const ConfigPush& other, mzm_coord& x, mzm_coord& y, bool& isLeft) const
+{
+	// Only a push changes the insets.
+	if (other.m_insetsId == m_insetsId)
+		return false;
+	y = other.m_y;
+	isLeft = (other.getInsets()[y] < getInsets()[y]);
+	// The push moved the player one position along the row.
+	const mzm_coord xx = isLeft ? (other.m_xx - 1) : (other.m_xx + 1);
+	x = m_level.getWidth() - 1 - xx;
+	return true;
+}
+
+template class ConfigPush<unsigned int, false>;
+template class ConfigPush<unsigned long long, false>;
+template class ConfigPush<mzm_row, false>;
+template class ConfigPush<unsigned int, true>;
+template class ConfigPush<unsigned long long, true>;
+template class ConfigPush<mzm_row, true>;
+
+} // namespace mzm
@@ -0,0 +1,225 @@
+/* ***************************************************************************
+ * ConfigPush.hpp
+ * Copyright (c) 2008, 2010, 2020 Malcolm Tyrrell.
+ * All rights reserved. This program and the accompanying materials
+ * are made available under the terms of the GNU Public License v3.0
+ * which accompanies this distribution, and is available at
+ * http://gplv3.fsf.org/
+ * ***************************************************************************/
+
+#ifndef CONFIGPUSH_H_
+#define CONFIGPUSH_H_
+
+#include <cassert>
+#include <cstdlib>
+#include <vector>
+
+#include <mzm/Mazezam/MazezamData.hpp>
+#include <mzm/MazezamSolver/Zobrist.hpp>
+
+namespace mzm {
+
+template<class R> class InsetStore;
+
+/*!
+ * A Solver configuration representing a MazezaM level used for finding
+ * solutions with the fewest moves.
+ * Rather than a configuration for every position the player walks through,
+ * there is one for the position the player is in straight after each push,
+ * at the start, and at the exit. A step of the search is a walk by the
+ * shortest way to a push and the push, or to the exit.
+ * A step costs its moves, and ties between paths of equal cost are broken by
+ * their number of steps, so a cheapest path of configurations is a solution
+ * with the fewest moves, and the fewest pushes of those. If PUSHES_FIRST is
+ * true, these are the other way round: a step costs one and ties are broken
+ * by moves, which gives the solution with the fewest moves of those with the
+ * fewest pushes. A path always has one step more than its pushes.
+ * As in ConfigEqv, the insets are kept once in a store shared by the search,
+ * so a configuration holds only their number whatever the height of the level,
+ * and needs no variants for short levels.
+ * Rows are handled as type R, which must be able to hold the rows of the level.
+ */
+template<class R, bool PUSHES_FIRST = false>
+class ConfigPush
+{
+public:
+	/*!
+	 * Constructor for the player just inside the entrance.
+	 * \param m the underlying level.
+	 */
+	ConfigPush(const MazezamData& m);
+
+	/*!
+	 * Constructor for the player just inside the entrance, for a search which
+	 * only passes through the insets in a corridor around the given ones (see
+	 * InsetStore::restrictTo).
+	 * \param m the underlying level.
+	 * \param corridor sets of insets, one after another.
+	 */
+	ConfigPush(const MazezamData& m, const std::vector<mzm_coord>& corridor);
+
+	/*!
+	 * Destructor.
+	 */
+	~ConfigPush();
+
+	/*!
+	 * Configurations are accounted for in the memory used by searches.
+	 */
+	static void* operator new(std::size_t size);
+	static void operator delete(void* config, std::size_t size);
+
+	/*!
+	 * The configurations which can be reached by walking to a push and making it,
+	 * or by walking to the exit.
+	 * \param v the vector into which to place the configurations.
+	 */
+	void getNeighbours(std::vector<ConfigPush*>& v) const;
+
+	/*!
+	 * Returns true if the player is at the goal.
+	 */
+	inline bool isGoal() const {
+		return (m_xx == 0) && (m_y == m_level.getFinish());
+	}
+
+	/*!
+	 * The number of moves of the step which reached the configuration.
+	 */
+	inline unsigned int getMoves() const {
+		return m_moves;
+	}
+
+	/*!
+	 * The cost of the step which reached the configuration.
+	 */
+	inline unsigned int getCost() const {
+		return PUSHES_FIRST ? 1 : m_moves;
+	}
+
+	/*!
+	 * The cost of the step by which ties between paths of the same cost are broken.
+	 */
+	inline unsigned int getTieCost() const {
+		return PUSHES_FIRST ? m_moves : 1;
+	}
+
+	/*!
+	 * Returns an estimate of the distance to the goal, which is never more than
+	 * the number of moves to it.
+	 */
+	inline float getEstimatedDistance () const {
+		return m_xx + abs(((int) m_level.getFinish()) - ((int) m_y));
+	}
+
+	/*!
+	 * Returns a Zobrist hash of the configuration.
+	 */
+	mzm_hash getHash() const;
+
+	/*!
+	 * Compare by contents, which means comparing the numbers of the insets
+	 * and the position.
+	 * \param other the other configuration.
+	 */
+	inline bool operator< (const ConfigPush& other) const {
+		assert (m_store == other.m_store);
+		if (m_insetsId != other.m_insetsId)
+			return m_insetsId < other.m_insetsId;
+		if (m_xx != other.m_xx)
+			return m_xx > other.m_xx;
+		return m_y < other.m_y;
+	}
+
+	/*!
+	 * If the step from this configuration to other ends with a push, find it.
+	 * \param other the configuration after the step.
+	 * \param x a reference in which the x coord from which the push is made is placed.
+	 * \param y a reference in which the y coord from which the push is made is placed.
+	 * \param isLeft a reference in which the direction is placed.
+	 * \return false if the step is a walk to the exit.
+	 */
+	bool findPush(const ConfigPush& other, mzm_coord& x, mzm_coord& y, bool& isLeft) const;
+public:
+	/*!
+	 * The underlying level.
+	 */
+	const MazezamData& m_level;
+protected:
+	/*!
+	 * The insets of this search.
+	 */
+	InsetStore<R>* m_store;
+
+	/*!
+	 * The number of the insets in the store.
+	 */
+	unsigned int m_insetsId;
+
+	/*!
+	 * The number of moves of the step which reached the configuration.
+	 */
+	unsigned int m_moves;
+
+	/*!
+	 * The character's x coord counted from the right of the level.
+	 */
+	mzm_coord m_xx;
+
+	/*!
+	 * The character's y coord.
+	 */
+	mzm_coord m_y;
+protected:
+	/*!
+	 * Set up the store, and the insets of the start of the search.
+	 * \param corridor the corridor to restrict the search to, or NULL.
+	 */
+	void startSearch(const std::vector<mzm_coord>* corridor);
+
+	/*!
+	 * The amount each row has been pushed rightwards.
+	 */
+	const mzm_coord* getInsets() const;
+
+	/*!
+	 * The state of the yth row.
+	 * \param inset the insets.
+	 * \param y the row.
+	 * \return the state of the yth row.
+	 */
+	R row(const mzm_coord* inset, mzm_coord y) const;
+
+	/*!
+	 * Add the configurations after the pushes which can be made from the
+	 * positions in a row of a layer of the walk search.
+	 * \param layer the positions, in the form (1 << xx).
+	 * \param y the row.
+	 * \param moves the number of moves of the walk to them and the push.
+	 */
+	void addPushes(std::vector<ConfigPush*>& v, R layer, mzm_coord y, unsigned int moves) const;
+
+	/*!
+	 * Assignment private and unimplemented.
+	 */
+	ConfigPush& operator=(const ConfigPush& c);
+
+	/*!
+	 * Copy constructor private and unimplemented.
+	 */
+	ConfigPush(const ConfigPush& c);
+
+	/*!
+	 * Private constructor for the configuration after a step.
+	 * \param parent the configuration before the step.
+	 * \param insetsId the number of the insets after the step.
+	 * \param xx the x coord after the step, counted from the right.
+	 * \param y the y coord after the step.
+	 * \param moves the number of moves of the step.
+	 */
+	ConfigPush(const ConfigPush& parent, unsigned int insetsId, mzm_coord xx, mzm_coord y, unsigned int moves);
+};
+
+} // namespace mzm
+
+#endif /*CONFIGPUSH_H_*/
@@ -0,0 +1,166 @@
+/* ***************************************************************************
+ * InsetStore.cpp
+ * Copyright (c) 2008, 2010, 2020 Malcolm Tyrrell.
+ * All rights reserved. This program and the accompanying materials
+ * are made available under the terms of the GNU Public License v3.0
+ * which accompanies this distribution, and is available at
+ * http://gplv3.fsf.org/
+ * ***************************************************************************/
+
+#include <cassert>
+
+#include <mzm/MazezamSolver/InsetStore.hpp>
+#include <mzmslv/MemoryAccount.hpp>
+
+namespace mzm {
+
+template<class R>
+const unsigned int InsetStore<R>::NO_ID;
+
+template<class R>
+const unsigned int InsetStore<R>::NO_INSETS;
+
+template<class R>
+InsetStore<R>::InsetStore(const MazezamData& level)
+: m_level(level)
+, m_rows(level.getHeight())
+, m_table(1024, NO_ID)
+, m_scratch(level.getHeight())
+, m_zoneScratch(level.getHeight())
+, m_pushScratch(2 * level.getHeight())
+, m_walkScratch(4 * level.getHeight())
+, m_zones(level)
+, m_accountedBytes(0)
+, m_references(0)
+{
+	for (int i = 0; i < level.getHeight(); ++i)
+		m_rows[i] = (R) level.getRow(i);
+	account();
+}
+
+template<class R>
+InsetStore<R>::~InsetStore()
+{
+	for (std::vector<mzm_coord*>::iterator it = m_blocks.begin(); it != m_blocks.end(); ++it)
+		delete[] *it;
+	mzmslv::MemoryAccount::freed(mzmslv::SolverStats::KIND_ARRAYS, m_accountedBytes);
+}
+
+template<class R>
+void InsetStore<R>::account()
+{
+	const unsigned long bytes = (m_rows.size() * sizeof(R)) + ((m_zoneScratch.size() + m_pushScratch.size() + m_walkScratch.size()) * sizeof(R)) + (m_blocks.size() * BLOCK_SIZE * m_level.getHeight() * sizeof(mzm_coord))
+		+ (m_hashes.capacity() * sizeof(mzm_hash)) + (m_table.size() * sizeof(unsigned int)) + (m_corridor.size() * sizeof(mzm_coord));
+	if (bytes > m_accountedBytes)
+		mzmslv::MemoryAccount::allocated(mzmslv::SolverStats::KIND_ARRAYS, bytes - m_accountedBytes);
+	else if (bytes < m_accountedBytes)
+		mzmslv::MemoryAccount::freed(mzmslv::SolverStats::KIND_ARRAYS, m_accountedBytes - bytes);
+	m_accountedBytes = bytes;
+}
+
+template<class R>
+void InsetStore<R>::restrictTo(const std::vector<mzm_coord>& corridor)
+{
+	assert (m_hashes.empty());
+	assert (!corridor.empty() && (corridor.size() % m_level.getHeight() == 0));
+	m_corridor = corridor;
+	account();
+}
+
+template<class R>
+bool InsetStore<R>::isInCorridor() const
+{
+	const int height = m_level.getHeight();
+	for (unsigned int k = 0; k < m_corridor.size(); k += height) {
+		// A push changes one row by one.
+		int changes = 0;
+		for (int i = 0; (i < height) && (changes < 2); ++i) {
+			const int change = m_scratch[i] - m_corridor[k + i];
+			if (change)
+				changes += ((change == 1) || (change == -1)) ? 1 : 2;
+		}
+		if (changes < 2)
+			return true;
+	}
+	return false;
+}
+
+template<class R>
+unsigned int InsetStore<R>::intern(const mzm_coord* inset)
+{
+	assert (m_level.checkInsets(inset));
+	for (int i = 0; i < m_level.getHeight(); ++i)
+		m_scratch[i] = inset[i];
+	return internScratch(Zobrist::getInsetsHash(m_level.getHeight(), inset));
+}
+
+template<class R>
+unsigned int InsetStore<R>::internPush(unsigned int insetsId, mzm_coord y, bool wasLeft)
+{
+	const mzm_coord* inset = getInsets(insetsId);
+	for (int i = 0; i < m_level.getHeight(); ++i)
+		m_scratch[i] = inset[i];
+	if (wasLeft)
+		--m_scratch[y];
+	else
+		++m_scratch[y];
+	assert (m_level.checkInsets(&m_scratch[0]));
+	const mzm_hash insetsHash = getHash(insetsId) ^ Zobrist::getInsetKey(y, inset[y]) ^ Zobrist::getInsetKey(y, m_scratch[y]);
+	assert (insetsHash == Zobrist::getInsetsHash(m_level.getHeight(), &m_scratch[0]));
+	return internScratch(insetsHash);
+}
+
+template<class R>
+unsigned int InsetStore<R>::internScratch(mzm_hash insetsHash)
+{
+	const int height = m_level.getHeight();
+	const unsigned int mask = m_table.size() - 1;
+	unsigned int slot = insetsHash & mask;
+	for (; m_table[slot] != NO_ID; slot = (slot + 1) & mask) {
+		const unsigned int insetsId = m_table[slot];
+		if (m_hashes[insetsId] != insetsHash)
+			continue;
+		const mzm_coord* inset = getInsets(insetsId);
+		int i = 0;
+		while ((i < height) && (inset[i] == m_scratch[i]))
+			++i;
+		if (i == height)
+			return insetsId;
+	}
+
+	// They haven't been seen before.
+	if (!m_corridor.empty() && !isInCorridor())
+		return NO_INSETS;
+	const unsigned int insetsId = m_hashes.size();
+	if (insetsId % BLOCK_SIZE == 0)
+		m_blocks.push_back(new mzm_coord[BLOCK_SIZE * height]);
+	mzm_coord* inset = m_blocks.back() + (insetsId % BLOCK_SIZE) * height;
+	for (int i = 0; i < height; ++i)
+		inset[i] = m_scratch[i];
+	m_hashes.push_back(insetsHash);
+	m_table[slot] = insetsId;
+	if (2 * m_hashes.size() > m_table.size())
+		grow();
+	account();
+	return insetsId;
+}
+
+template<class R>
+void InsetStore<R>::grow()
+{
+	std::vector<unsigned int> table(2 * m_table.size(), NO_ID);
+	const unsigned int mask = table.size() - 1;
+	for (unsigned int insetsId = 0; insetsId < m_hashes.size(); ++insetsId) {
+		unsigned int slot = m_hashes[insetsId] & mask;
+		while (table[slot] != NO_ID)
+			slot = (slot + 1) & mask;
+		table[slot] = insetsId;
+	}
+	m_table.swap(table);
+}
+
+template class InsetStore<unsigned int>;
+template class InsetStore<unsigned long long>;
+template class InsetStore<mzm_row>;
+
+} // namespace mzm
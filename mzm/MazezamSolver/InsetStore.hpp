@@ -0,0 +1,248 @@
+/* ***************************************************************************
+ * InsetStore.hpp
+ * Copyright (c) 2008, 2010, 2020 Malcolm Tyrrell.
+ * All rights reserved. This program and the accompanying materials
+ * are made available under the terms of the GNU Public License v3.0
+ * which accompanies this distribution, and is available at
+ * http://gplv3.fsf.org/
+ * ***************************************************************************/
+
+#ifndef INSETSTORE_H_
+#define INSETSTORE_H_
+
+#include <vector>
+
+#include <mzm/Mazezam/MazezamData.hpp>
+#include <mzm/MazezamSolver/Zobrist.hpp>
+#include <mzm/MazezamSolver/ZoneCache.hpp>
+
+namespace mzm {
+
+/*!
+ * The insets of the configurations of one search, each distinct set of which
+ * is stored once and identified by a number, so configurations with the same
+ * insets share them, and have the same insets exactly if they have the same
+ * number.
+ * The store also keeps the labellings of the zones of recently used insets.
+ * The store is owned by the configurations which use it: it is deleted when
+ * the last of them is. Like the configurations, it must only be used by one
+ * thread at a time.
+ * The rows of the zones are of type R.
+ */
+template<class R>
+class InsetStore
+{
+public:
+	/*!
+	 * Constructor. The store starts with no references.
+	 * \param level the underlying level.
+	 */
+	InsetStore(const MazezamData& level);
+
+	/*!
+	 * Add a reference to the store.
+	 */
+	inline void addReference() { ++m_references; }
+
+	/*!
+	 * Remove a reference to the store, deleting it if it was the last.
+	 */
+	inline void removeReference() {
+		if (--m_references == 0)
+			delete this;
+	}
+
+	/*!
+	 * Only store insets in a corridor around the given ones: those which are
+	 * one of them, or a push away from one of them. Other insets are refused.
+	 * This must be called before any insets are stored.
+	 * \param corridor sets of insets, one after another.
+	 */
+	void restrictTo(const std::vector<mzm_coord>& corridor);
+
+	/*!
+	 * Get the number of some insets, storing them if they haven't been seen before.
+	 * \param inset the insets.
+	 * \return the number, or NO_INSETS if the insets are refused.
+	 */
+	unsigned int intern(const mzm_coord* inset);
+
+	/*!
+	 * Get the number of the insets which result from a push.
+	 * \param insetsId the number of the insets before the push.
+	 * \param y the row which was pushed.
+	 * \param wasLeft if the push was left or right.
+	 * \return the number, or NO_INSETS if the insets are refused.
+	 */
+	unsigned int internPush(unsigned int insetsId, mzm_coord y, bool wasLeft);
+
+	/*!
+	 * Returned for insets which aren't in the corridor the store is restricted to.
+	 */
+	static const unsigned int NO_INSETS = ~0U;
+
+	/*!
+	 * The insets with the given number. They never move.
+	 */
+	inline const mzm_coord* getInsets(unsigned int insetsId) const {
+		return m_blocks[insetsId / BLOCK_SIZE] + (insetsId % BLOCK_SIZE) * m_level.getHeight();
+	}
+
+	/*!
+	 * The yth row of the level, before it is inset.
+	 */
+	inline R getRow(mzm_coord y) const {
+		return m_rows[y];
+	}
+
+	/*!
+	 * The hash of the insets with the given number.
+	 */
+	inline mzm_hash getHash(unsigned int insetsId) const {
+		return m_hashes[insetsId];
+	}
+
+	/*!
+	 * Get the labelling of the zones of the insets with the given number.
+	 * The labelling remains valid until the next call, which may relabel it.
+	 */
+	inline const ZoneLabelling<R>& getLabelling(unsigned int insetsId) {
+		return m_zones.getLabelling(insetsId, getInsets(insetsId));
+	}
+
+	/*!
+	 * Storage for a copy of a zone, one row per row of the level, which is
+	 * reused so that expanding a configuration allocates nothing.
+	 */
+	inline std::vector<R>& getZoneScratch() {
+		return m_zoneScratch;
+	}
+
+	/*!
+	 * Storage for the zone and the free positions of a configuration after a push,
+	 * two rows per row of the level, which is reused in the same way.
+	 */
+	inline std::vector<R>& getPushScratch() {
+		return m_pushScratch;
+	}
+
+	/*!
+	 * Storage for the rows of a walk search, four per row of the level, which
+	 * is reused in the same way.
+	 */
+	inline std::vector<R>& getWalkScratch() {
+		return m_walkScratch;
+	}
+private:
+	/*!
+	 * Only deleted by removeReference.
+	 */
+	~InsetStore();
+
+	/*!
+	 * Get the number of the insets in m_scratch, whose hash is given.
+	 */
+	unsigned int internScratch(mzm_hash insetsHash);
+
+	/*!
+	 * Are the insets in m_scratch in the corridor?
+	 */
+	bool isInCorridor() const;
+
+	/*!
+	 * Double the size of the hash table.
+	 */
+	void grow();
+
+	/*!
+	 * Bring the memory accounted for the store up to date.
+	 */
+	void account();
+
+	/*!
+	 * The number of sets of insets in each block.
+	 */
+	static const unsigned int BLOCK_SIZE = 4096;
+
+	/*!
+	 * Marks an empty slot of the hash table.
+	 */
+	static const unsigned int NO_ID = ~0U;
+
+	/*!
+	 * The underlying level.
+	 */
+	const MazezamData& m_level;
+
+	/*!
+	 * The rows of the level, narrowed to R.
+	 */
+	std::vector<R> m_rows;
+
+	/*!
+	 * The insets, in blocks of BLOCK_SIZE sets, so they never move once stored.
+	 */
+	std::vector<mzm_coord*> m_blocks;
+
+	/*!
+	 * The hashes of the insets.
+	 */
+	std::vector<mzm_hash> m_hashes;
+
+	/*!
+	 * The hash table of the numbers of the insets, which is open addressed, and
+	 * whose size is a power of two at least twice the number of insets.
+	 */
+	std::vector<unsigned int> m_table;
+
+	/*!
+	 * Where insets are put together before being interned.
+	 */
+	std::vector<mzm_coord> m_scratch;
+
+	/*!
+	 * The insets around which insets are stored, one set after another, or
+	 * none if all insets are stored.
+	 */
+	std::vector<mzm_coord> m_corridor;
+
+	/*!
+	 * Where zones are copied.
+	 */
+	std::vector<R> m_zoneScratch;
+
+	/*!
+	 * Where zones after pushes are found.
+	 */
+	std::vector<R> m_pushScratch;
+
+	/*!
+	 * Where walks are searched for.
+	 */
+	std::vector<R> m_walkScratch;
+
+	/*!
+	 * The labellings of the zones of recently used insets.
+	 */
+	ZoneCache<R> m_zones;
+
+	/*!
+	 * The bytes which have been accounted for the store, apart from its labellings.
+	 */
+	unsigned long m_accountedBytes;
+
+	/*!
+	 * The number of references.
+	 */
+	unsigned int m_references;
+
+	/*!
+	 * Copying private and unimplemented.
+	 */
+	InsetStore(const InsetStore&);
+	InsetStore& operator=(const InsetStore&);
+};
+
+} // namespace mzm
+
+#endif /*INSETSTORE_H_*/
@@ -9,9 +9,11 @@
 
 #include "MazezamImprover.hpp"
 
+#include <algorithm>
 #include <cstdlib>
 #include <cassert>
 
+#include <mzmcommon/Tracer/Tracer.hpp>
 #include <mzm/MazezamSolver/MazezamSolverJob.hpp>
 #include <mzm/MazezamSolver/SolutionCollector.hpp>
 #include <mzm/MazezamSolver/Selection.hpp>
@@ -24,7 +26,7 @@ MazezamImprover::MazezamImprover (const MazezamData& m, MazezamRating startRatin
 , m_workerPool(workerPool)
 , m_selection(selection)
 , m_radius(radius)
-, m_bestLevel(m)
+, m_bestLevel(m_level)
 , m_bestRating(startRating)
 {
 	// One before the position to start considering.
@@ -35,31 +37,26 @@ MazezamImprover::~MazezamImprover ()
 {
 }
 
-MazezamData* MazezamImprover::getNeighbourLevel() const
+SharedLevel MazezamImprover::getNeighbourLevel() const
 {
-	MazezamData* newMazezam = new MazezamData(m_level);
-	const int numChanges = m_changes.size();
-	for (int i = 0; i < numChanges; ++i) {
-		assert(m_changes[i] != indexOfEntrance());
-		const div_t coords = div(m_changes[i], m_level.getWidth());
-		newMazezam->setBlock(coords.quot, coords.rem, !newMazezam->getBlock(coords.quot, coords.rem));
-	}
-	return newMazezam;
+	// The changes are numbered row by row, as the toggles of a shared level are.
+	assert(std::find(m_changes.begin(), m_changes.end(), indexOfEntrance()) == m_changes.end());
+	return SharedLevel(m_level, m_changes);
 }
 
 int MazezamImprover::indexOfEntrance() const
 {
-	return m_level.getStart() * m_level.getWidth();
+	return m_level->getStart() * m_level->getWidth();
 }
 
 int MazezamImprover::getNextIndex(int current) const
 {
 	++current;
 	if (m_selection) {
-		div_t coords = div(current, m_level.getWidth());
-		while ((coords.quot < m_level.getHeight()) && (!m_selection->isSelected(coords.quot, coords.rem) || (current == indexOfEntrance()))) {
+		div_t coords = div(current, m_level->getWidth());
+		while ((coords.quot < m_level->getHeight()) && (!m_selection->isSelected(coords.quot, coords.rem) || (current == indexOfEntrance()))) {
 			++current;
-			coords = div(current, m_level.getWidth());
+			coords = div(current, m_level->getWidth());
 		}
 	} else if (current == indexOfEntrance())
 		++current;
@@ -73,10 +70,10 @@ bool MazezamImprover::advanceIndex(unsigned int pos)
 	if ((pos + 1 < m_changes.size()) && (current >= m_changes[pos + 1]))
 		return false;
 	// Changes must lie within the level.
-	if (current >= m_level.getWidth() * m_level.getHeight())
+	if (current >= m_level->getWidth() * m_level->getHeight())
 		return false;
 	// Current is a valid index for this position.
-	assert(!m_selection || m_selection->isSelected(current/m_level.getWidth(), current%m_level.getWidth()));
+	assert(!m_selection || m_selection->isSelected(current/m_level->getWidth(), current%m_level->getWidth()));
 	m_changes[pos] = current;
 	return true;
 }
@@ -128,31 +125,39 @@ void MazezamImprover::improveAsynchronously()
 
 mzmslv::WorkerPoolJob* MazezamImprover::getNextJob()
 {
-	if (advanceNeighbour()) {
-		MazezamData* nextLevel = getNeighbourLevel();
-		return new MazezamSolverJobFewestPushes(*nextLevel);
-		delete nextLevel;
-	} else
+	Tracer::Span span("improver", "make neighbour");
+	if (!advanceNeighbour())
 		return NULL;
+	mzmslv::WorkerPoolJob* job = createMazezamSolverJob(getNeighbourLevel(), MAZEZAM_SOLUTION_FEWEST_PUSHES);
+	// Trying neighbours is speculative.
+	job->setPriority(mzmslv::WorkerPoolJob::PRIORITY_LOW);
+	return job;
 }
 
 void MazezamImprover::jobDone(mzmslv::WorkerPoolJob* job)
 {
-	MazezamSolverJobFewestPushes* solverJob = static_cast<MazezamSolverJobFewestPushes*>(job);
+	Tracer::Span span("improver", "evaluate neighbour");
+	MazezamSolverJobBase* solverJob = static_cast<MazezamSolverJobBase*>(job);
+	// Only neighbours with a solution have a rating.
+	if (solverJob->getResult() != mzmslv::FOUND_SOLUTION) {
+		delete job;
+		return;
+	}
 	MazezamRating rating = solverJob->getRating();
-	if ((solverJob->getResult() == mzmslv::FOUND_SOLUTION) && (rating > m_bestRating)) {
+	if (rating > m_bestRating) {
 		m_collector.collectRating(0, rating);
-		m_collector.collectNumPushes(0, solverJob->getPath().size() - 1); 
-		m_collector.collectSolution(0, MAZEZAM_SOLUTION_FEWEST_PUSHES, *solverJob);
+		m_collector.collectNumPushes(0, solverJob->getNumSteps()); 
+		m_collector.collectSolution(0, MAZEZAM_SOLUTION_FEWEST_PUSHES, solverJob->getSolution());
 		m_bestLevel = solverJob->getLevel();
-		m_collector.collectImprovement(0, m_bestLevel);
+		m_collector.collectImprovement(0, *m_bestLevel);
 		m_bestRating = rating;
 	}
+	delete job;
 }
 
 const MazezamData& MazezamImprover::getBestLevel() const
 {
-	return m_bestLevel;
+	return *m_bestLevel;
 }
 
 void MazezamImprover::stop()
@@ -10,7 +10,9 @@
 #ifndef MAZEZAMIMPROVER_H_
 #define MAZEZAMIMPROVER_H_
 
-#include <mzm/Mazezam/MazezamData.hpp>
+#include <vector>
+
+#include <mzm/Mazezam/SharedLevel.hpp>
 #include <mzmslv/WorkerPool.hpp>
 #include <mzm/MazezamSolver/MazezamRatingType.hpp>
 
@@ -66,7 +68,7 @@ protected:
 	/*!
 	 * The starting level.
 	 */
-	const MazezamData& m_level;
+	SharedLevel m_level;
 	/*!
 	 * The collector to which we pass solutions. 
 	 */
@@ -92,7 +94,7 @@ protected:
 	/*!
 	 * The best level so far.
 	 */
-	MazezamData m_bestLevel;
+	SharedLevel m_bestLevel;
 	/*!
 	 * The best rating so far.
 	 */
@@ -123,10 +125,10 @@ private:
 	bool advanceNeighbour();
 	
 	/*!
-	 * Creates a config.
-	 * Note: The caller takes responsibility for deleting the underlying level.
+	 * The current neighbour, which shares the starting level and only keeps
+	 * the blocks it changes until it is solved.
 	 */
-	MazezamData* getNeighbourLevel() const;
+	SharedLevel getNeighbourLevel() const;
 	
 	//
 	// Private and unimplemented methods.
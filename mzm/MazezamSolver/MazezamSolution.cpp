@@ -0,0 +1,122 @@
+/* ***************************************************************************
+ * MazezamSolution.cpp
+ * Copyright (c) 2008, 2010, 2020 Malcolm Tyrrell.
+ * All rights reserved. This program and the accompanying materials
+ * are made available under the terms of the GNU Public License v3.0
+ * which accompanies this distribution, and is available at
+ * http://gplv3.fsf.org/
+ * ***************************************************************************/
+
+#include <mzm/MazezamSolver/MazezamSolution.hpp>
+
+#include <cassert>
+
+#include <mzmcommon/Tracer/Tracer.hpp>
+#include <mzm/MazezamSolver/WalkFinder.hpp>
+
+namespace mzm {
+
+MazezamSolution::MazezamSolution()
+: m_isExpanded(false)
+{
+}
+
+MazezamSolution::MazezamSolution(const SharedLevel& level)
+: m_level(level)
+, m_isExpanded(false)
+{
+}
+
+void MazezamSolution::addPush(mzm_coord x, mzm_coord y, bool isLeft)
+{
+	assert(!m_level.isNull() && !m_isExpanded);
+	Push push = { x, y, isLeft };
+	m_pushes.push_back(push);
+}
+
+bool MazezamSolution::isSolvable() const
+{
+	return !m_level.isNull();
+}
+
+unsigned int MazezamSolution::getNumPushes() const
+{
+	return m_pushes.size();
+}
+
+const SharedLevel& MazezamSolution::getLevel() const
+{
+	return m_level;
+}
+
+void MazezamSolution::getInsets(std::vector<mzm_coord>& inset) const
+{
+	assert(isSolvable());
+	const int height = m_level->getHeight();
+	inset.resize((m_pushes.size() + 1) * height);
+	for (int i = 0; i < height; ++i)
+		inset[i] = m_level->getInset(i);
+	for (unsigned int p = 0; p < m_pushes.size(); ++p) {
+		for (int i = 0; i < height; ++i)
+			inset[((p + 1) * height) + i] = inset[(p * height) + i];
+		if (m_pushes[p].m_isLeft)
+			--inset[((p + 1) * height) + m_pushes[p].m_y];
+		else
+			++inset[((p + 1) * height) + m_pushes[p].m_y];
+	}
+}
+
+const mzm_path& MazezamSolution::getPath() const
+{
+	assert(isSolvable());
+	if (!m_isExpanded) {
+		Tracer::Span span("output", "reconstruct path");
+		if (rowTypeFits<unsigned int>(m_level->getWidth()))
+			expand<unsigned int>();
+		else if (rowTypeFits<unsigned long long>(m_level->getWidth()))
+			expand<unsigned long long>();
+		else
+			expand<mzm_row>();
+		m_isExpanded = true;
+	}
+	return m_path;
+}
+
+unsigned int MazezamSolution::getNumMoves() const
+{
+	return getPath().size() - 2;
+}
+
+template<class R>
+void MazezamSolution::expand() const
+{
+	const MazezamData& level = *m_level;
+	WalkFinder<R> walkFinder(level);
+	std::vector<mzm_coord> inset(level.getHeight());
+	for (int i = 0; i < level.getHeight(); ++i)
+		inset[i] = level.getInset(i);
+	m_path.clear();
+	// The player steps in from the entrance.
+	m_path.push_back(DIR_EAST);
+	mzm_coord x = 0;
+	mzm_coord y = level.getStart();
+	for (std::vector<Push>::const_iterator it = m_pushes.begin(); it != m_pushes.end(); ++it) {
+		if (!walkFinder.addWalk(&inset[0], m_path, x, y, it->m_x, it->m_y))
+			throw NoSuchWalk();
+		if (it->m_isLeft) {
+			m_path.push_back(DIR_PUSH_WEST);
+			--x;
+			--inset[y];
+		} else {
+			m_path.push_back(DIR_PUSH_EAST);
+			++x;
+			++inset[y];
+		}
+	}
+	// The player steps out through the exit.
+	if (!walkFinder.addWalk(&inset[0], m_path, x, y, level.getWidth() - 1, level.getFinish()))
+		throw NoSuchWalk();
+	m_path.push_back(DIR_EAST);
+}
+
+} // namespace mzm
@@ -0,0 +1,120 @@
+/* ***************************************************************************
+ * MazezamSolution.hpp
+ * Copyright (c) 2008, 2010, 2020 Malcolm Tyrrell.
+ * All rights reserved. This program and the accompanying materials
+ * are made available under the terms of the GNU Public License v3.0
+ * which accompanies this distribution, and is available at
+ * http://gplv3.fsf.org/
+ * ***************************************************************************/
+
+#ifndef MAZEZAMSOLUTION_H_
+#define MAZEZAMSOLUTION_H_
+
+#include <vector>
+
+#include <mzm/Mazezam/PackedPath.hpp>
+#include <mzm/Mazezam/SharedLevel.hpp>
+
+namespace mzm {
+
+/*!
+ * A solution to a mazezam, or the lack of one.
+ * A solution is kept as the level and the pushes it makes. The walks between
+ * them are only found when the moves of the solution are first asked for, so
+ * solutions whose moves aren't needed (for a rating, say) are cheap to pass
+ * around.
+ */
+class MazezamSolution
+{
+public:
+	/*!
+	 * Constructor for the lack of a solution.
+	 */
+	MazezamSolution();
+	/*!
+	 * Constructor for a solution to the level, which makes no pushes until
+	 * they are added.
+	 * \param level the level which is solved.
+	 */
+	explicit MazezamSolution(const SharedLevel& level);
+
+	/*!
+	 * Add the next push of the solution.
+	 * \param x the x coord from which the push is made.
+	 * \param y the y coord from which the push is made.
+	 * \param isLeft true if the push is to the west.
+	 */
+	void addPush(mzm_coord x, mzm_coord y, bool isLeft);
+
+	/*!
+	 * Is there a solution?
+	 */
+	bool isSolvable() const;
+	/*!
+	 * The number of pushes the solution makes.
+	 */
+	unsigned int getNumPushes() const;
+	/*!
+	 * The level which is solved.
+	 */
+	const SharedLevel& getLevel() const;
+	/*!
+	 * Get the insets of the level at the start and after each push.
+	 * \param inset where to put them, one set after another.
+	 */
+	void getInsets(std::vector<mzm_coord>& inset) const;
+
+	/*!
+	 * Exception class thrown by getPath if the pushes can't be reached.
+	 */
+	class NoSuchWalk {};
+
+	/*!
+	 * Get the moves of the solution, which are found the first time this is called.
+	 * Between its pushes, the solution walks by the shortest way.
+	 * \throw NoSuchWalk if a push or the exit can't be reached.
+	 */
+	const mzm_path& getPath() const;
+	/*!
+	 * The number of moves the solution makes in the level, which doesn't
+	 * count the steps in through the entrance and out through the exit.
+	 * The moves are found if they haven't been.
+	 * \throw NoSuchWalk if a push or the exit can't be reached.
+	 */
+	unsigned int getNumMoves() const;
+private:
+	/*!
+	 * The level which is solved, or null if there's no solution.
+	 */
+	SharedLevel m_level;
+	/*!
+	 * A push made by the solution.
+	 */
+	struct Push {
+		mzm_coord m_x;
+		mzm_coord m_y;
+		bool m_isLeft;
+	};
+	/*!
+	 * The pushes, in order.
+	 */
+	std::vector<Push> m_pushes;
+	/*!
+	 * Have the moves been found?
+	 */
+	mutable bool m_isExpanded;
+	/*!
+	 * The moves, once they have been found.
+	 */
+	mutable mzm_path m_path;
+
+	/*!
+	 * Add the moves of the solution to m_path, walking with rows of type R.
+	 */
+	template<class R>
+	void expand() const;
+};
+
+} // namespace mzm
+
+#endif /*MAZEZAMSOLUTION_H_*/
@@ -24,7 +24,7 @@ MazezamSolutionType extractNextSolutionType(unsigned int& flags)
 unsigned int getSearches(unsigned int& flags)
 {
 	unsigned int searches = flags & MAZEZAM_SOLUTION_SEARCHES;
-	if ((flags & MAZEZAM_SOLUTION_RATING) || (flags & MAZEZAM_SOLUTION_NUM_PUSHES))
+	if ((flags & MAZEZAM_SOLUTION_RATING) || (flags & MAZEZAM_SOLUTION_NUM_PUSHES) || (flags & MAZEZAM_SOLUTION_MOVES_BOUND))
 		searches |= MAZEZAM_SOLUTION_FEWEST_PUSHES;
 	if (flags & MAZEZAM_SOLUTION_NUM_MOVES)
 		searches |= MAZEZAM_SOLUTION_FEWEST_MOVES;
@@ -18,6 +18,7 @@ namespace mzm {
 enum MazezamSolutionTypeIndices {
 	MAZEZAM_SOLUTION_FEWEST_PUSHES_INDEX,
 	MAZEZAM_SOLUTION_FEWEST_MOVES_INDEX,
+	MAZEZAM_SOLUTION_FEWEST_PUSHES_THEN_MOVES_INDEX,
 	MAZEZAM_SOLUTION_FASTEST_INDEX,
 	
 	MAZEZAM_SOLUTION_MAX_SEARCHES_INDEX = MAZEZAM_SOLUTION_FASTEST_INDEX,
@@ -25,6 +26,7 @@ enum MazezamSolutionTypeIndices {
 	MAZEZAM_SOLUTION_RATING_INDEX,
 	MAZEZAM_SOLUTION_NUM_PUSHES_INDEX,
 	MAZEZAM_SOLUTION_NUM_MOVES_INDEX,
+	MAZEZAM_SOLUTION_MOVES_BOUND_INDEX,
 	/*!
 	 * The number of solution types.
 	 */
@@ -39,6 +41,7 @@ enum MazezamSolutionType {
 	
 	MAZEZAM_SOLUTION_FEWEST_PUSHES = 1 << MAZEZAM_SOLUTION_FEWEST_PUSHES_INDEX,
 	MAZEZAM_SOLUTION_FEWEST_MOVES  = 1 << MAZEZAM_SOLUTION_FEWEST_MOVES_INDEX,
+	MAZEZAM_SOLUTION_FEWEST_PUSHES_THEN_MOVES = 1 << MAZEZAM_SOLUTION_FEWEST_PUSHES_THEN_MOVES_INDEX,
 	MAZEZAM_SOLUTION_FASTEST       = 1 << MAZEZAM_SOLUTION_FASTEST_INDEX,
 	
 	MAZEZAM_SOLUTION_SEARCHES      = (1 << (MAZEZAM_SOLUTION_MAX_SEARCHES_INDEX + 1)) - 1,
@@ -46,6 +49,7 @@ enum MazezamSolutionType {
 	MAZEZAM_SOLUTION_RATING        = 1 << MAZEZAM_SOLUTION_RATING_INDEX,
 	MAZEZAM_SOLUTION_NUM_PUSHES    = 1 << MAZEZAM_SOLUTION_NUM_PUSHES_INDEX,
 	MAZEZAM_SOLUTION_NUM_MOVES     = 1 << MAZEZAM_SOLUTION_NUM_MOVES_INDEX, 
+	MAZEZAM_SOLUTION_MOVES_BOUND   = 1 << MAZEZAM_SOLUTION_MOVES_BOUND_INDEX,
 	
 	MAZEZAM_SOLUTION_ALL           = (1 << MAZEZAM_SOLUTION_NUM_TYPES) - 1
 };
@@ -11,18 +11,35 @@
 
 namespace mzm {
 
-mzmslv::WorkerPoolJob* createMazezamSolverJob(const MazezamData& m, MazezamSolutionType type)
+/*!
+ * Create a job which searches using rows of type R.
+ */
+template<class R>
+static MazezamSolverJobBase* createMazezamSolverJob(const SharedLevel& m, MazezamSolutionType type, bool boundMoves)
 {
 	switch(type) {
 		case MAZEZAM_SOLUTION_FEWEST_PUSHES:
-			return new MazezamSolverJobFewestPushes(m);
+			return new MazezamSolverJobFewestPushes<R>(m, boundMoves);
 		case MAZEZAM_SOLUTION_FEWEST_MOVES:
-			return new MazezamSolverJobFewestMoves(m);
+			return new MazezamSolverJobFewestMoves<R>(m, boundMoves);
+		case MAZEZAM_SOLUTION_FEWEST_PUSHES_THEN_MOVES:
+			return new MazezamSolverJobFewestMoves<R, true>(m, boundMoves);
 		case MAZEZAM_SOLUTION_FASTEST:
-			return new MazezamSolverJobFastest(m);
+			return new MazezamSolverJobFastest<R>(m, boundMoves);
 		default:
 			assert(false);
+			return NULL;
 	}
 }
 
+MazezamSolverJobBase* createMazezamSolverJob(const SharedLevel& m, MazezamSolutionType type, bool boundMoves)
+{
+	if (rowTypeFits<unsigned int>(m->getWidth()))
+		return createMazezamSolverJob<unsigned int>(m, type, boundMoves);
+	else if (rowTypeFits<unsigned long long>(m->getWidth()))
+		return createMazezamSolverJob<unsigned long long>(m, type, boundMoves);
+	else
+		return createMazezamSolverJob<mzm_row>(m, type, boundMoves);
+}
+
 } // namespace mzm
\ No newline at end of file
@@ -13,82 +13,145 @@
 #include <cassert>
 #include <cmath>
 
-#include <mzm/MazezamSolver/Config.hpp>
+#include <mzm/Mazezam/SharedLevel.hpp>
+#include <mzm/MazezamSolver/ConfigPush.hpp>
 #include <mzm/MazezamSolver/ConfigEqv.hpp>
 #include <mzmslv/SolverJob.hpp>
 #include <mzm/MazezamSolver/MazezamSolutionType.hpp>
-#include <mzm/MazezamSolver/MazezamSolutionSource.hpp>
+#include <mzm/MazezamSolver/MazezamSolution.hpp>
+#include <mzm/MazezamSolver/MovesBound.hpp>
 #include <mzm/MazezamSolver/MazezamRatingType.hpp>
 
 namespace mzm {
 
 /*!
- * A worker job which solves Mazezams.
- * Subclasses for specific use-cases are provided below.
+ * The interface of the worker jobs which solve Mazezams, whatever type of
+ * configuration they search with.
  */
-template<class C>
-class MazezamSolverJob : protected MazezamData, public mzmslv::SolverJob<C>, public MazezamSolutionSource
+class MazezamSolverJobBase : public mzmslv::WorkerPoolJob
 {
 public:
 	/*!
-	 * Get an mzmPath corresponding to the solution.
+	 * Gets the result of the job.
+	 */
+	virtual mzmslv::SolverResult getResult() const = 0;
+	/*!
+	 * Gets the memory use of the search and its hardware event counts, if counting was enabled.
 	 */
-	virtual void addToMzmPath(mzm_path& path) const;
+	virtual const mzmslv::SolverStats& getStats() const = 0;
 	/*!
-	 * Return if the mazezam is solvable.
+	 * Get the solution which was found, or the lack of one. Only its pushes
+	 * are found here: its moves are found when they are first needed.
 	 */
-	virtual bool isSolvable() const;
+	virtual MazezamSolution getSolution() const = 0;
+	/*!
+	 * Get the number of steps (pushes or moves, depending on the type) of the solution.
+	 */
+	virtual unsigned int getNumSteps() const = 0;
+	/*!
+	 * Get the bound on the moves found from the solution (see findMovesBound),
+	 * which the job must have been created to find.
+	 */
+	virtual unsigned int getMovesBound() const = 0;
 	/*!
 	 * Get a rating of the mazezam using this solution.
 	 */
-	MazezamRating getRating() const;
+	virtual MazezamRating getRating() const = 0;
 	/*!
-	 * Get a const reference to the level which was solved.
+	 * Get the level which was solved.
 	 */
-	const MazezamData& getLevel() const;
+	virtual const SharedLevel& getLevel() const = 0;
 	/*!
 	 * Get the type of solution.
 	 */
+	virtual MazezamSolutionType getType() const = 0;
+};
+
+/*!
+ * A worker job which solves Mazezams.
+ * Subclasses for specific use-cases are provided below.
+ * The configurations refer to the level, so the level is a base: it is
+ * released after the solver job has deleted them.
+ */
+template<class C>
+class MazezamSolverJob : private SharedLevel, public mzmslv::SolverJob<C, MazezamSolverJobBase>
+{
+public:
+	// MazezamSolverJobBase interface.
+	virtual MazezamSolution getSolution() const;
+	virtual unsigned int getNumSteps() const;
+	virtual unsigned int getMovesBound() const;
+	virtual MazezamRating getRating() const;
+	virtual const SharedLevel& getLevel() const;
 	virtual MazezamSolutionType getType() const { return MAZEZAM_SOLUTION_INVALID_TYPE; }
+	
+	// WorkerPoolJob interface.
+	virtual mzmslv::WorkerPoolJob::Outcome doJob();
+	virtual const char* getTypeName() const;
 protected:
 	/*!
 	 * Constructor.
+	 * \param boundMoves if the job should find a bound on the moves as soon as
+	 * it has found its solution, so that it's found on the pool's thread rather
+	 * than by whoever collects the results.
 	 */
-	MazezamSolverJob(const MazezamData& m, mzmslv::SearchType type);
+	MazezamSolverJob(const SharedLevel& m, mzmslv::SearchType type, bool boundMoves);
+private:
+	typedef mzmslv::SolverJob<C, MazezamSolverJobBase> Base;
+	/*!
+	 * If the job should find a bound on the moves.
+	 */
+	bool m_boundMoves;
+	/*!
+	 * The bound on the moves, once it has been found.
+	 */
+	unsigned int m_movesBound;
 };
 
 /*!
- * Factory method.
+ * Factory method. The job searches using rows of the narrowest type which
+ * can hold the rows of the level.
+ * \param boundMoves if the job should find a bound on the moves from its solution as well.
  */
-mzmslv::WorkerPoolJob* createMazezamSolverJob(const MazezamData& m, MazezamSolutionType type);
+MazezamSolverJobBase* createMazezamSolverJob(const SharedLevel& m, MazezamSolutionType type, bool boundMoves = false);
 
 /*!
- * A WorkerPoolJob for solving mazezams which finds a solution with the fewest moves.
+ * A WorkerPoolJob for solving mazezams which finds a solution with the fewest
+ * moves, and the fewest pushes of those. If PUSHES_FIRST is true, it finds a
+ * solution with the fewest pushes, and the fewest moves of those.
+ * It searches from push to push, so the steps of its path are walks of several moves.
+ * The number of steps of the solution is its number of moves either way.
  */
-class MazezamSolverJobFewestMoves : public MazezamSolverJob<Config>
+template<class R, bool PUSHES_FIRST = false>
+class MazezamSolverJobFewestMoves : public MazezamSolverJob<ConfigPush<R, PUSHES_FIRST> >
 {
 public:
-	MazezamSolverJobFewestMoves(const MazezamData& m) : MazezamSolverJob<Config>(m, mzmslv::BREADTH_FIRST) {}
-	virtual MazezamSolutionType getType() const { return MAZEZAM_SOLUTION_FEWEST_MOVES; }	
+	MazezamSolverJobFewestMoves(const SharedLevel& m, bool boundMoves = false) : MazezamSolverJob<ConfigPush<R, PUSHES_FIRST> >(m, mzmslv::UNIFORM_COST, boundMoves) {}
+	virtual MazezamSolutionType getType() const {
+		return PUSHES_FIRST ? MAZEZAM_SOLUTION_FEWEST_PUSHES_THEN_MOVES : MAZEZAM_SOLUTION_FEWEST_MOVES;
+	}
+	virtual unsigned int getNumSteps() const;
 };
 
 /*!
  * A WorkerPoolJob for solving mazezams which finds a solution with the fewest pushes.
  */
-class MazezamSolverJobFewestPushes : public MazezamSolverJob<ConfigEqv>
+template<class R>
+class MazezamSolverJobFewestPushes : public MazezamSolverJob<ConfigEqv<R> >
 {
 public:
-	MazezamSolverJobFewestPushes(const MazezamData& m) : MazezamSolverJob<ConfigEqv>(m, mzmslv::BREADTH_FIRST) {}
+	MazezamSolverJobFewestPushes(const SharedLevel& m, bool boundMoves = false) : MazezamSolverJob<ConfigEqv<R> >(m, mzmslv::BREADTH_FIRST, boundMoves) {}
 	virtual MazezamSolutionType getType() const { return MAZEZAM_SOLUTION_FEWEST_PUSHES; }	
 };
 
 /*!
  * A WorkerPoolJob for solving mazezams which finds a solution as fast as possible.
  */
-class MazezamSolverJobFastest : public MazezamSolverJob<ConfigEqv>
+template<class R>
+class MazezamSolverJobFastest : public MazezamSolverJob<ConfigEqv<R> >
 {
 public:
-	MazezamSolverJobFastest(const MazezamData& m) : MazezamSolverJob<ConfigEqv>(m, mzmslv::DEPTH_FIRST) {}
+	MazezamSolverJobFastest(const SharedLevel& m, bool boundMoves = false) : MazezamSolverJob<ConfigEqv<R> >(m, mzmslv::DEPTH_FIRST, boundMoves) {}
 	virtual MazezamSolutionType getType() const { return MAZEZAM_SOLUTION_FASTEST; }
 };
 
@@ -97,47 +160,96 @@ public:
 
 
 template<class C>
-MazezamSolverJob<C>::MazezamSolverJob(const MazezamData& m, mzmslv::SearchType type)
-: MazezamData(m)
-, mzmslv::SolverJob<C>(type, new C(*this))
+MazezamSolverJob<C>::MazezamSolverJob(const SharedLevel& m, mzmslv::SearchType type, bool boundMoves)
+: SharedLevel(m)
+, Base(type, new C(*m))
+, m_boundMoves(boundMoves)
+, m_movesBound(0)
+{
+}
+
+template<class C>
+mzmslv::WorkerPoolJob::Outcome MazezamSolverJob<C>::doJob()
+{
+	const mzmslv::WorkerPoolJob::Outcome outcome = Base::doJob();
+	if (m_boundMoves && (Base::m_solverResult == mzmslv::FOUND_SOLUTION)) {
+		// The search for the bound is part of the job's memory use.
+		mzmslv::MemoryAccount account(Base::m_stats);
+		m_movesBound = findMovesBound(getSolution());
+	}
+	return outcome;
+}
+
+template<class C>
+MazezamSolution MazezamSolverJob<C>::getSolution() const
 {
+	if (Base::m_solverResult != mzmslv::FOUND_SOLUTION)
+		return MazezamSolution();
+	assert(Base::m_solutionPath.size() > 0);
+	MazezamSolution solution(getLevel());
+	mzm_coord x, y;
+	bool isLeft;
+	for (unsigned int i = 0; i < Base::m_solutionPath.size() - 1; ++i)
+		if (Base::m_solutionPath[i]->findPush(*Base::m_solutionPath[i+1], x, y, isLeft))
+			solution.addPush(x, y, isLeft);
+	return solution;
 }
 
 template<class C>
-void MazezamSolverJob<C>::addToMzmPath(mzm_path& path) const
+unsigned int MazezamSolverJob<C>::getNumSteps() const
 {
-	assert(mzmslv::SolverJob<C>::m_solverResult == mzmslv::FOUND_SOLUTION);
-	assert(mzmslv::SolverJob<C>::m_solutionPath.size() > 0);
-	const C* init = mzmslv::SolverJob<C>::m_solutionPath[0];
-	const MazezamData& level = init->m_level; 
-	mzm_coord x = 0;
-	mzm_coord y = level.getStart();
-	init->addInitialMoves(path,x,y);
-	for(unsigned int i = 0; i < mzmslv::SolverJob<C>::m_solutionPath.size() - 1; ++i)
-		mzmslv::SolverJob<C>::m_solutionPath[i]->addMoves(*mzmslv::SolverJob<C>::m_solutionPath[i+1],path,x,y);
-	// There is a final move "East" which the solver does not account for.
-	mzmslv::SolverJob<C>::m_solutionPath.back()->addFinalMoves(path,x,y);
+	assert(Base::m_solutionPath.size() > 0);
+	return Base::m_solutionPath.size() - 1;
 }
 
 template<class C>
-bool MazezamSolverJob<C>::isSolvable() const
+unsigned int MazezamSolverJob<C>::getMovesBound() const
 {
-	return mzmslv::SolverJob<C>::m_solverResult == mzmslv::FOUND_SOLUTION;
+	assert(m_boundMoves && (Base::m_solverResult == mzmslv::FOUND_SOLUTION));
+	return m_movesBound;
 }
 
 template<class C>
 float MazezamSolverJob<C>::getRating() const
 {
-	assert(mzmslv::SolverJob<C>::m_solutionPath.size() > 0);
-	const float numPushes = mzmslv::SolverJob<C>::m_solutionPath.size() - 1;
-	const float diag = sqrt((getWidth() * getWidth()) + (getHeight() * getHeight()));
+	assert(Base::m_solutionPath.size() > 0);
+	const float numPushes = Base::m_solutionPath.size() - 1;
+	const float diag = sqrt((getLevel()->getWidth() * getLevel()->getWidth()) + (getLevel()->getHeight() * getLevel()->getHeight()));
 	return numPushes / diag;
 }
 
 template<class C>
-const MazezamData& MazezamSolverJob<C>::getLevel() const
+const char* MazezamSolverJob<C>::getTypeName() const
+{
+	switch (getType()) {
+		case MAZEZAM_SOLUTION_FEWEST_PUSHES:
+			return "fewest pushes";
+		case MAZEZAM_SOLUTION_FEWEST_MOVES:
+			return "fewest moves";
+		case MAZEZAM_SOLUTION_FEWEST_PUSHES_THEN_MOVES:
+			return "fewest pushes then moves";
+		case MAZEZAM_SOLUTION_FASTEST:
+			return "fastest";
+		default:
+			return "mazezam";
+	}
+}
+
+template<class R, bool PUSHES_FIRST>
+unsigned int MazezamSolverJobFewestMoves<R, PUSHES_FIRST>::getNumSteps() const
+{
+	const typename mzmslv::Solver<ConfigPush<R, PUSHES_FIRST> >::path& path = this->getPath();
+	assert(path.size() > 0);
+	unsigned int numMoves = 0;
+	for (unsigned int i = 1; i < path.size(); ++i)
+		numMoves += path[i]->getMoves();
+	return numMoves;
+}
+
+template<class C>
+const SharedLevel& MazezamSolverJob<C>::getLevel() const
 {
-	return *static_cast<const MazezamData*>(this);
+	return *static_cast<const SharedLevel*>(this);
 }
 
 } // namespace mzm
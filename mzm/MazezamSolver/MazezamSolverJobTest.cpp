@@ -0,0 +1,100 @@
+/* ***************************************************************************
+ * MazezamSolverJobTest.cpp
+ * Copyright (c) 2008, 2010, 2020 Malcolm Tyrrell.
+ * All rights reserved. This program and the accompanying materials
+ * are made available under the terms of the GNU Public License v3.0
+ * which accompanies this distribution, and is available at
+ * http://gplv3.fsf.org/
+ * ***************************************************************************/
+
+#include <iostream>
+#include <sstream>
+
+#include <mzm/MazezamSolver/MazezamSolverJob.hpp>
+#include <mzm/MzmReaders/DummyOStream.hpp>
+#include <mzm/MzmReaders/FileMzmReader.hpp>
+
+using namespace mzm;
+
+namespace {
+
+/*!
+ * Levels in which the search for the fewest moves reaches some configurations
+ * more cheaply, or with fewer pushes, after it first reaches them.
+ */
+const char* const LEVELS =
+	"########\n"
+	"# $$  $#\n"
+	"#   $ $#\n"
+	"+   $$ #\n"
+	"# $ $  *\n"
+	"########\n"
+	"\n"
+	"########\n"
+	"+   $  #\n"
+	"#   $ $#\n"
+	"# $ $$ #\n"
+	"#  $$  *\n"
+	"########\n"
+	"\n"
+	"#######\n"
+	"# $$$ *\n"
+	"+ $  $#\n"
+	"#  $ $#\n"
+	"# $   #\n"
+	"#######\n"
+	"\n"
+	"###########\n"
+	"#       $ #\n"
+	"#$$$ $$ $$#\n"
+	"#$ $  $$  #\n"
+	"#  $$  $ $*\n"
+	"+ $$$$    #\n"
+	"###########\n";
+
+/*!
+ * Returns true if the number of moves given by a job searching for the given
+ * type of solution is the number of moves of the solution it found.
+ */
+bool countsMoves(const SharedLevel& level, int levelNumber, MazezamSolutionType type)
+{
+	MazezamSolverJobBase* job = createMazezamSolverJob(level, type);
+	job->doJob();
+	bool counted = true;
+	if (job->getResult() != mzmslv::FOUND_SOLUTION) {
+		std::cerr << "Level " << levelNumber << " wasn't solved" << std::endl;
+		counted = false;
+	} else if (job->getNumSteps() != job->getSolution().getNumMoves()) {
+		std::cerr << "Level " << levelNumber << " (" << job->getTypeName() << ") counted " << job->getNumSteps()
+			<< " moves for a solution of " << job->getSolution().getNumMoves() << std::endl;
+		counted = false;
+	}
+	delete job;
+	return counted;
+}
+
+}
+
+int main()
+{
+	std::istringstream is(LEVELS);
+	DummyOStream os;
+	FileMzmReader reader(is, "", os);
+	int failures = 0;
+	int levelNumber = 0;
+	while (reader.next()) {
+		MazezamData* data = reader.getLevel();
+		const SharedLevel level(*data);
+		delete data;
+		++levelNumber;
+		if (!countsMoves(level, levelNumber, MAZEZAM_SOLUTION_FEWEST_MOVES))
+			++failures;
+		if (!countsMoves(level, levelNumber, MAZEZAM_SOLUTION_FEWEST_PUSHES_THEN_MOVES))
+			++failures;
+	}
+	if (levelNumber != 4) {
+		std::cerr << "Read " << levelNumber << " levels rather than 4" << std::endl;
+		++failures;
+	}
+	return failures == 0 ? 0 : 1;
+}
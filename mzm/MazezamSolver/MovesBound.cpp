@@ -0,0 +1,56 @@
+/* ***************************************************************************
+ * MovesBound.cpp
+ * Copyright (c) 2008, 2010, 2020 Malcolm Tyrrell.
+ * All rights reserved. This program and the accompanying materials
+ * are made available under the terms of the GNU Public License v3.0
+ * which accompanies this distribution, and is available at
+ * http://gplv3.fsf.org/
+ * ***************************************************************************/
+
+#include <mzm/MazezamSolver/MovesBound.hpp>
+
+#include <cassert>
+#include <vector>
+
+#include <mzmcommon/Tracer/Tracer.hpp>
+#include <mzm/MazezamSolver/ConfigPush.hpp>
+#include <mzmslv/Solver.hpp>
+
+namespace mzm {
+
+/*!
+ * Find the bound, searching with rows of type R.
+ */
+template<class R>
+static unsigned int findMovesBound(const MazezamSolution& solution)
+{
+	std::vector<mzm_coord> corridor;
+	solution.getInsets(corridor);
+	mzmslv::Solver<ConfigPush<R> > solver;
+	typename mzmslv::Solver<ConfigPush<R> >::path path;
+	const mzmslv::SolverResult result = solver.findSolution(mzmslv::UNIFORM_COST, new ConfigPush<R>(*solution.getLevel(), corridor), path);
+	// The solution itself is in the corridor.
+	assert (result == mzmslv::FOUND_SOLUTION);
+	if (result != mzmslv::FOUND_SOLUTION)
+		return solution.getNumMoves();
+	unsigned int numMoves = 0;
+	for (unsigned int i = 1; i < path.size(); ++i)
+		numMoves += path[i]->getMoves();
+	mzmslv::Solver<ConfigPush<R> >::deletePath(path);
+	return numMoves;
+}
+
+unsigned int findMovesBound(const MazezamSolution& solution)
+{
+	assert(solution.isSolvable());
+	Tracer::Span span("search", "bound moves");
+	const int width = solution.getLevel()->getWidth();
+	if (rowTypeFits<unsigned int>(width))
+		return findMovesBound<unsigned int>(solution);
+	else if (rowTypeFits<unsigned long long>(width))
+		return findMovesBound<unsigned long long>(solution);
+	else
+		return findMovesBound<mzm_row>(solution);
+}
+
+} // namespace mzm
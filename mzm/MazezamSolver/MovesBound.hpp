@@ -0,0 +1,31 @@
+/* ***************************************************************************
+ * MovesBound.hpp
+ * Copyright (c) 2008, 2010, 2020 Malcolm Tyrrell.
+ * All rights reserved. This program and the accompanying materials
+ * are made available under the terms of the GNU Public License v3.0
+ * which accompanies this distribution, and is available at
+ * http://gplv3.fsf.org/
+ * ***************************************************************************/
+
+#ifndef MOVESBOUND_H_
+#define MOVESBOUND_H_
+
+#include <mzm/MazezamSolver/MazezamSolution.hpp>
+
+namespace mzm {
+
+/*!
+ * Find an upper bound on the fewest moves of a level from a solution of it,
+ * which is much quicker than finding the fewest moves.
+ * The fewest moves are searched for as by MazezamSolverJobFewestMoves, but only
+ * through a corridor of insets around those the solution passes through, so
+ * the bound is never more than the moves of the solution.
+ * \param solution a solution of the level.
+ * \return the bound, which like MazezamSolution::getNumMoves doesn't count the
+ * steps in through the entrance and out through the exit.
+ */
+unsigned int findMovesBound(const MazezamSolution& solution);
+
+} // namespace mzm
+
+#endif /*MOVESBOUND_H_*/
@@ -26,43 +26,67 @@ MultiMazezamSolver::MultiMazezamSolver(mzmslv::WorkerPool& workerPool, SolutionC
 
 void MultiMazezamSolver::jobDone(mzmslv::WorkerPoolJob* job)
 {
-	assert(m_currentWork.find(job) != m_currentWork.end());
-	WorkUnderway underway = m_currentWork[job];
-	m_currentWork.erase(job);
-	
-	MazezamSolutionSource* source;
+	collectBatch(static_cast<Batch*>(job));
+}
+
+bool MultiMazezamSolver::isBoundingMoves(MazezamSolutionType type) const
+{
+	return (type == MAZEZAM_SOLUTION_FEWEST_PUSHES) && (m_solutionTypeFlags & MAZEZAM_SOLUTION_MOVES_BOUND);
+}
+
+void MultiMazezamSolver::collectBatch(Batch* batch)
+{
+	// The jobs of a batch are in level order.
+	const int numJobs = batch->getNumJobs();
+	for (int i = 0; i < numJobs; ++i)
+		collectResults(batch->getJob(i), batch->getWork(i));
+	delete batch;
+}
+
+void MultiMazezamSolver::collectResults(mzmslv::WorkerPoolJob* job, const WorkUnderway& underway)
+{
+	MazezamSolverJobBase* mazezamJob = static_cast<MazezamSolverJobBase*>(job);
+	assert (mazezamJob->getType() == underway.m_solutionType);
+	const MazezamSolution solution = mazezamJob->getSolution();
 	
-	switch (underway.m_solutionType) {
-		case MAZEZAM_SOLUTION_FEWEST_PUSHES: {
-			MazezamSolverJobFewestPushes* mazezamJob = static_cast<MazezamSolverJobFewestPushes*>(job);
-			if (mazezamJob->getResult() == mzmslv::FOUND_SOLUTION) {
+	if (mazezamJob->getResult() == mzmslv::FOUND_SOLUTION) {
+		switch (underway.m_solutionType) {
+			case MAZEZAM_SOLUTION_FEWEST_PUSHES:
 				if (m_solutionTypeFlags & MAZEZAM_SOLUTION_RATING)
 					m_collector.collectRating(underway.m_levelNumber, mazezamJob->getRating());
 				if (m_solutionTypeFlags & MAZEZAM_SOLUTION_NUM_PUSHES)
-					m_collector.collectNumPushes(underway.m_levelNumber, mazezamJob->getPath().size() - 1);
-			}
-			source = mazezamJob;
-			break;
-		}
-		case MAZEZAM_SOLUTION_FEWEST_MOVES: {
-			MazezamSolverJobFewestMoves* mazezamJob = static_cast<MazezamSolverJobFewestMoves*>(job);
-			if (mazezamJob->getResult() == mzmslv::FOUND_SOLUTION) {
+					m_collector.collectNumPushes(underway.m_levelNumber, mazezamJob->getNumSteps());
+				// The solution bounds the moves long before the search for the
+				// fewest is done. The job has already found the bound.
+				if (m_solutionTypeFlags & MAZEZAM_SOLUTION_MOVES_BOUND)
+					m_collector.collectMovesBound(underway.m_levelNumber, mazezamJob->getMovesBound());
+				break;
+			case MAZEZAM_SOLUTION_FEWEST_MOVES:
 				if (m_solutionTypeFlags & MAZEZAM_SOLUTION_NUM_MOVES)
-					m_collector.collectNumMoves(underway.m_levelNumber, mazezamJob->getPath().size() - 1);
-			}
-			source = mazezamJob;
-			break;
+					m_collector.collectNumMoves(underway.m_levelNumber, mazezamJob->getNumSteps());
+				break;
+			case MAZEZAM_SOLUTION_FEWEST_PUSHES_THEN_MOVES:
+			case MAZEZAM_SOLUTION_FASTEST:
+				break;
+			default:
+				assert(false);
 		}
-		case MAZEZAM_SOLUTION_FASTEST:
-			source = static_cast<MazezamSolverJobFastest*>(job);
-			break;
-		default:
-			assert(false);
+	} else if ((underway.m_solutionType == MAZEZAM_SOLUTION_FEWEST_PUSHES) && (m_solutionTypeFlags & MAZEZAM_SOLUTION_RATING)) {
+		// The solution itself may not have been asked for, so the lack of one is passed on as a rating.
+		m_collector.collectRating(underway.m_levelNumber, MAZEZAM_RATING_UNSOLVABLE);
 	}
-	
+
 	if (m_solutionTypeFlags & underway.m_solutionType) {
-		m_collector.collectSolution(underway.m_levelNumber, underway.m_solutionType, *source);
+		m_collector.collectSolution(underway.m_levelNumber, underway.m_solutionType, solution);
 	}
+	m_collector.collectSolverStats(underway.m_levelNumber, underway.m_solutionType, mazezamJob->getStats());
+}
+
+void MultiMazezamSolver::Batch::addJob(const SharedLevel& level, int levelNumber, MazezamSolutionType type, bool boundMoves)
+{
+	WorkerPoolBatchJob::addJob(createMazezamSolverJob(level, type, boundMoves));
+	WorkUnderway underway = { levelNumber, type };
+	m_work.push_back(underway);
 }
 
 } // namespace mzm
@@ -10,10 +10,11 @@
 #ifndef MULTIMAZEZAMSOLVER_H_
 #define MULTIMAZEZAMSOLVER_H_
 
-#include <map>
+#include <vector>
 
 #include <mzmslv/WorkerPool.hpp>
-#include <mzm/Mazezam/MazezamData.hpp>
+#include <mzmslv/WorkerPoolBatchJob.hpp>
+#include <mzm/Mazezam/SharedLevel.hpp>
 #include <mzm/MazezamSolver/MazezamSolutionType.hpp>
 #include <mzm/MazezamSolver/MazezamRatingType.hpp>
 
@@ -62,9 +63,44 @@ protected:
 		MazezamSolutionType m_solutionType;
 	};
 	/*!
-	 * The mapping of job pointers to WorkUnderway structures.
+	 * The jobs given to the pool are batches of solver jobs, which carry
+	 * the work each of their jobs is doing.
 	 */
-	std::map<mzmslv::WorkerPoolJob*, WorkUnderway> m_currentWork; 
+	class Batch : public mzmslv::WorkerPoolBatchJob
+	{
+	public:
+		/*!
+		 * Add a job to the batch.
+		 * \param level the level to solve, which the job shares.
+		 * \param levelNumber the number of the level.
+		 * \param type the type of solution to find.
+		 * \param boundMoves if the job should find a bound on the moves from its solution as well.
+		 */
+		void addJob(const SharedLevel& level, int levelNumber, MazezamSolutionType type, bool boundMoves);
+		/*!
+		 * Get the work being done by the ith job of the batch.
+		 */
+		const WorkUnderway& getWork(int i) const { return m_work[i]; }
+	private:
+		/*!
+		 * The work being done by each job.
+		 */
+		std::vector<WorkUnderway> m_work;
+	};
+	/*!
+	 * Returns true if the job for the given type of solution should find a bound
+	 * on the moves from it. The job finds it, so that it isn't found while the
+	 * results are collected, which holds up the pool's other threads.
+	 */
+	bool isBoundingMoves(MazezamSolutionType type) const;
+	/*!
+	 * Pass the results of the jobs in a finished batch to the collector, and delete the batch.
+	 */
+	void collectBatch(Batch* batch);
+	/*!
+	 * Pass the results of a finished job to the collector.
+	 */
+	void collectResults(mzmslv::WorkerPoolJob* job, const WorkUnderway& underway);
 };
 
 } // namespace mzm
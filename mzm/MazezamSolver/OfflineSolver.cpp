@@ -12,6 +12,8 @@
 #include <cassert>
 #include <memory>
 
+#include <mzmcommon/Tracer/Tracer.hpp>
+
 #include <mzm/MazezamSolver/MazezamSolverJob.hpp>
 #include <mzm/MazezamSolver/SolutionCollector.hpp>
 
@@ -21,9 +23,20 @@ OfflineSolver::OfflineSolver(MzmReader& r, mzmslv::WorkerPool& workerPool, Solut
 : MultiMazezamSolver(workerPool, collector)
 , m_mzmReader(r)
 , m_copyMode(copyMode)
+, m_noMoreLevels(false)
+, m_parseError(NULL)
 {
 	m_solutionTypeFlags = solutionTypeFlags;
 	m_outstandingFlags = 0;
+	sem_init(&m_resultItemsQueued, 0, 0);
+	sem_init(&m_resultsFlushed, 0, 0);
+}
+
+OfflineSolver::~OfflineSolver()
+{
+	sem_destroy(&m_resultItemsQueued);
+	sem_destroy(&m_resultsFlushed);
+	delete m_parseError;
 }
 
 
@@ -31,40 +44,167 @@ mzmslv::WorkerPoolJob* OfflineSolver::getNextJob()
 {
 	if ( !m_outstandingFlags ) {
 		// Copy mode does all solutions for each level separately.
-		if (m_copyMode || !m_mzmReader.next())
+		if (m_copyMode || !readNextLevel())
 			return NULL;
+	}
 	
-		setUpForNextLevel(); 
+	Batch* batch = new Batch;
+	unsigned int cost = estimateCost(*m_level);
+	
+	if (cost >= BATCH_COST) {
+		// Do the searches of an expensive level in separate jobs.
+		MazezamSolutionType type = extractNextSolutionType(m_outstandingFlags);
+		batch->addJob(m_level, m_mzmReader.getLevelNumber(), type, isBoundingMoves(type));
+		return batch;
 	}
 	
-	std::auto_ptr<MazezamData> level(m_mzmReader.getLevel());
-	MazezamSolutionType type = extractNextSolutionType(m_outstandingFlags);
-	mzmslv::WorkerPoolJob* job = createMazezamSolverJob(*level, type);
-	WorkUnderway underway = { m_mzmReader.getLevelNumber(), type }; 
-	m_currentWork[job] = underway;
+	// Batch cheap levels together, with all their searches.
+	for (;;) {
+		while (m_outstandingFlags) {
+			MazezamSolutionType type = extractNextSolutionType(m_outstandingFlags);
+			batch->addJob(m_level, m_mzmReader.getLevelNumber(), type, isBoundingMoves(type));
+		}
+		
+		if (m_copyMode || !readNextLevel())
+			break;
+		
+		const unsigned int levelCost = estimateCost(*m_level);
+		if (cost + levelCost >= BATCH_COST)
+			// Leave the level for the next batch.
+			break;
+		cost += levelCost;
+	}
 	
-	return job;
+	return batch;
 }
 
 
+void OfflineSolver::jobDone(mzmslv::WorkerPoolJob* job)
+{
+	queueResultItem(ResultItem::BATCH, 0, static_cast<Batch*>(job));
+}
+
 void OfflineSolver::solve()
 {
-	if (m_copyMode) {
-		// Copy mode does work for each level separately.
-		while (m_mzmReader.next()) {
-			setUpForNextLevel();
+	pthread_create(&m_resultThread, NULL, resultThreadStartPoint, this);
+	try {
+		if (m_copyMode) {
+			// Copy mode does work for each level separately.
+			while (readNextLevel()) {
+				m_workerPool.workSynchronous(this);
+				// The solutions must be written before the level is copied.
+				flushResults();
+				m_mzmReader.copyLevel();
+			}
+		} else {
 			m_workerPool.workSynchronous(this);
-			m_mzmReader.copyLevel();
 		}
-	} else {
-		m_workerPool.workSynchronous(this);
+		if (m_parseError)
+			m_parseError->raise();
+	} catch (...) {
+		finishResults();
+		throw;
 	}
+	finishResults();
 }
 
 void OfflineSolver::setUpForNextLevel()
 {
+	std::auto_ptr<MazezamData> level(m_mzmReader.getLevel());
+	m_level = SharedLevel(*level);
 	m_outstandingFlags = getSearches(m_solutionTypeFlags);
-	m_collector.collectLevelNumber(m_mzmReader.getLevelNumber());	
+	queueResultItem(ResultItem::LEVEL_NUMBER, m_mzmReader.getLevelNumber(), NULL);
+}
+
+bool OfflineSolver::readNextLevel()
+{
+	if (m_noMoreLevels)
+		return false;
+	try {
+		m_noMoreLevels = !m_mzmReader.next();
+	} catch (const MzmReader::ParseError& e) {
+		// This may be a pool thread, so the error is thrown later by solve.
+		m_parseError = e.clone();
+		m_noMoreLevels = true;
+	}
+	if (m_noMoreLevels)
+		return false;
+	setUpForNextLevel();
+	return true;
+}
+
+unsigned int OfflineSolver::estimateCost(const MazezamData& level)
+{
+	const mzm_coord height = level.getHeight();
+	const mzm_coord width = level.getWidth();
+	unsigned int cost = height * width;
+	for (mzm_coord r = 0; r < height; ++r) {
+		// Rows are left aligned, so the number of insets a row can have
+		// is one more than the number of empty cells at its right.
+		const mzm_row row = level.getRow(r);
+		unsigned int numInsets = 1;
+		if (row)
+			for (mzm_row bit = 1; !(row & bit); bit = bit << 1)
+				++numInsets;
+		cost *= numInsets;
+		if (cost >= BATCH_COST)
+			return BATCH_COST;
+	}
+	return cost;
+}
+
+void OfflineSolver::queueResultItem(ResultItem::Kind kind, int levelNumber, Batch* batch)
+{
+	ResultItem item = { kind, levelNumber, batch };
+	m_resultItems.push(item);
+	sem_post(&m_resultItemsQueued);
+}
+
+void OfflineSolver::flushResults()
+{
+	queueResultItem(ResultItem::FLUSH, 0, NULL);
+	while (sem_wait(&m_resultsFlushed) != 0)
+		;
+}
+
+void OfflineSolver::finishResults()
+{
+	queueResultItem(ResultItem::FINISH, 0, NULL);
+	pthread_join(m_resultThread, NULL);
+}
+
+void* OfflineSolver::resultThreadStartPoint(void* arg)
+{
+	static_cast<OfflineSolver*>(arg)->processResults();
+	return NULL;
+}
+
+void OfflineSolver::processResults()
+{
+	Tracer::nameThread("results");
+	for (;;) {
+		while (sem_wait(&m_resultItemsQueued) != 0)
+			;
+		// The semaphore counts the items, so there is one to pop.
+		ResultItem item = ResultItem();
+		if (!m_resultItems.pop(item)) {
+			assert(false);
+			continue;
+		}
+		switch (item.m_kind) {
+			case ResultItem::LEVEL_NUMBER:
+				m_collector.collectLevelNumber(item.m_levelNumber);
+				break;
+			case ResultItem::BATCH:
+				collectBatch(item.m_batch);
+				break;
+			case ResultItem::FLUSH:
+				sem_post(&m_resultsFlushed);
+				break;
+			case ResultItem::FINISH:
+				return;
+		}
+	}
 }
 
 } // namespace mzm
@@ -11,15 +11,19 @@
 #define OFFLINESOLVER_H_
 
 #include <map>
+#include <pthread.h>
+#include <semaphore.h>
+#include <mzmslv/LockFreeQueue.hpp>
 #include <mzm/MazezamSolver/MultiMazezamSolver.hpp>
 #include <mzm/MzmReaders/MzmReader.hpp>
 #include <mzm/RangePred/RangePred.hpp>
-#include <mzm/MazezamSolver/Config.hpp>
 
 namespace mzm {
 
 /*!
  * A class which reads a set of mazezams and solves them using a worker pool.
+ * The results of finished jobs are passed to the collector by a thread of their own,
+ * so the pool threads don't wait while solutions are reconstructed and written out.
  */
 class OfflineSolver : public MultiMazezamSolver
 {
@@ -29,28 +33,115 @@ public:
 	 * \param copyMode if true, then solutions to one level are output before the next one is read.
 	 */
 	OfflineSolver(MzmReader& r, mzmslv::WorkerPool& workerPool, SolutionCollector& collector, unsigned int solutionTypeFlags, bool copyMode);
+	/*!
+	 * Destructor.
+	 */
+	virtual ~OfflineSolver();
 	/*!
 	 * Solve the levels using the worker pool synchronously.
+	 * \throw MzmReader::ParseError (as thrown by the reader) if a level couldn't
+	 * be read, after the levels before it have been solved.
 	 */
 	void solve();
 	
 	// WorkerPoolClient interface.
 	virtual mzmslv::WorkerPoolJob* getNextJob();
+	virtual void jobDone(mzmslv::WorkerPoolJob* job);
 private:
 	/*!
 	 * The source of the mazezams.
 	 */
 	MzmReader& m_mzmReader;
+	/*!
+	 * The level which was read last, which the jobs for its searches share.
+	 */
+	SharedLevel m_level;
 	/*!
 	 * If in copyMode, then we must output the solutions to one level before
 	 * we read the next one. Naturally, this limits concurrency.
 	 */
 	bool m_copyMode;
+	/*!
+	 * Set when the reader has run out of levels.
+	 */
+	bool m_noMoreLevels;
+	/*!
+	 * A parse error met while reading levels, or NULL. Levels may be read on
+	 * pool threads, so the error is kept and thrown by solve.
+	 */
+	MzmReader::ParseError* m_parseError;
+	/*!
+	 * Levels are batched together until the estimated cost of a batch reaches this.
+	 * A level estimated to cost more than this on its own has a job for each of its searches.
+	 */
+	static const unsigned int BATCH_COST = 1 << 16;
+	/*!
+	 * Something for the result thread to do.
+	 */
+	struct ResultItem {
+		enum Kind {
+			LEVEL_NUMBER,
+			BATCH,
+			FLUSH,
+			FINISH
+		};
+		Kind m_kind;
+		int m_levelNumber;
+		Batch* m_batch;
+	};
+	/*!
+	 * The items waiting for the result thread. Items are only queued by one thread
+	 * at a time: either the main thread, or a thread holding the pool's client lock.
+	 */
+	mzmslv::LockFreeQueue<ResultItem> m_resultItems;
+	/*!
+	 * Counts the items in the queue.
+	 */
+	sem_t m_resultItemsQueued;
+	/*!
+	 * Posted by the result thread when it reaches a FLUSH item.
+	 */
+	sem_t m_resultsFlushed;
+	/*!
+	 * The thread which passes results to the collector.
+	 */
+	pthread_t m_resultThread;
 private:
 	/*!
 	 * Set up state for a new level. 
 	 */
 	void setUpForNextLevel();
+	/*!
+	 * Read the next level, if there is one, and set up for it.
+	 * \return false if there are no more levels.
+	 */
+	bool readNextLevel();
+	/*!
+	 * A rough estimate of the cost of searching a level: the number of ways
+	 * its rows could be arranged, times the number of places the person could be.
+	 * \return the estimate, or BATCH_COST if it is at least that.
+	 */
+	static unsigned int estimateCost(const MazezamData& level);
+	/*!
+	 * Queue an item for the result thread.
+	 */
+	void queueResultItem(ResultItem::Kind kind, int levelNumber, Batch* batch);
+	/*!
+	 * Wait until the result thread has dealt with all the items queued so far.
+	 */
+	void flushResults();
+	/*!
+	 * Tell the result thread to finish once it has dealt with the queued items, and join it.
+	 */
+	void finishResults();
+	/*!
+	 * The result thread start point (which must be static).
+	 */
+	static void* resultThreadStartPoint(void* arg);
+	/*!
+	 * Pass queued items to the collector until a FINISH item is reached.
+	 */
+	void processResults();
 };
 
 } // namespace mzm
@@ -10,33 +10,42 @@
 #include <mzm/MazezamSolver/OutstreamSolutionCollector.hpp>
 
 #include <cassert>
+#include <ostream>
+#include <mzmcommon/Tracer/Tracer.hpp>
+#include <mzmslv/SolverStats.hpp>
 
 namespace mzm {
 
 OutstreamSolutionCollector::OutstreamSolutionCollector(std::ostream& os, unsigned int solutionTypeFlags, bool copyMode)
 : m_outStream(os)
+, m_statsStream(0)
 , m_solutionTypeFlags(solutionTypeFlags)
 , m_copyMode(copyMode)
 {
 }
 
+void OutstreamSolutionCollector::setStatsStream(std::ostream* statsStream)
+{
+	m_statsStream = statsStream;
+}
+
 void OutstreamSolutionCollector::collectLevelNumber(unsigned int levelNumber)
 {
 	m_levelNumbers.push_back(levelNumber);
 }
 
-void OutstreamSolutionCollector::collectSolution(unsigned int levelNumber, MazezamSolutionType solutionType, const MazezamSolutionSource& source)
+void OutstreamSolutionCollector::collectSolution(unsigned int levelNumber, MazezamSolutionType solutionType, const MazezamSolution& solution)
 {
-	if (source.isSolvable()) {
+	if (solution.isSolvable()) {
 		assert(solutionType & m_solutionTypeFlags);
 		PerLevelOutput& output = findOutput(levelNumber);
 		// Check we haven't already seen this solution?
 		assert(solutionType & output.m_outstandingFlags);
 		output.m_outstandingFlags &= ~solutionType;
-		Solution solution;
-		solution.m_solutionType = solutionType;
-		source.addToMzmPath(solution.m_solution);
-		output.m_solutions.push_back(solution);
+		Solution buffered;
+		buffered.m_solutionType = solutionType;
+		buffered.m_solution = solution;
+		output.m_solutions.push_back(buffered);
 	} else {
 		PerLevelOutput& output = findOutput(levelNumber);
 		output.m_outstandingFlags &= ~solutionType;
@@ -45,7 +54,7 @@ void OutstreamSolutionCollector::collectSolution(unsigned int levelNumber, Mazez
 	postCollectCheck();
 }
 
-void OutstreamSolutionCollector::collectRating(unsigned int levelNumber, MazezamRating rating, unsigned int numPushes)
+void OutstreamSolutionCollector::collectRating(unsigned int levelNumber, MazezamRating rating)
 {
 	PerLevelOutput& output = findOutput(levelNumber);
 	output.m_outstandingFlags &= ~MAZEZAM_SOLUTION_RATING;
@@ -54,6 +63,30 @@ void OutstreamSolutionCollector::collectRating(unsigned int levelNumber, Mazezam
 	postCollectCheck();
 }
 
+/*!
+ * A name for the search which finds a type of solution.
+ */
+static const char* getSearchName(MazezamSolutionType solutionType)
+{
+	switch (solutionType) {
+		case MAZEZAM_SOLUTION_FEWEST_PUSHES:
+			return "Pushes";
+		case MAZEZAM_SOLUTION_FEWEST_MOVES:
+			return "Moves";
+		case MAZEZAM_SOLUTION_FEWEST_PUSHES_THEN_MOVES:
+			return "PushesThenMoves";
+		default:
+			return "Fastest";
+	}
+}
+
+void OutstreamSolutionCollector::collectSolverStats(unsigned int levelNumber, MazezamSolutionType solutionType, const mzmslv::SolverStats& stats)
+{
+	// The statistics are diagnostics, so they are written straight away rather than being buffered with the output.
+	if (m_statsStream)
+		*m_statsStream << "Level " << levelNumber << " (" << getSearchName(solutionType) << "): " << stats << "\n";
+}
+
 OutstreamSolutionCollector::PerLevelOutput& OutstreamSolutionCollector::findOutput(unsigned int levelNumber)
 {
 	std::list<PerLevelOutput>::iterator iterator = m_bufferedOutput.begin();
@@ -99,6 +132,7 @@ void OutstreamSolutionCollector::postCollectCheck()
 
 void OutstreamSolutionCollector::writeOutput(const PerLevelOutput& output) const
 {
+	Tracer::Span span("output", "write output");
 	const int numSolutions = output.m_solutions.size();
 	if (!m_copyMode)
 		m_outStream << "Level " << output.m_levelNumber << "\n";
@@ -111,13 +145,16 @@ void OutstreamSolutionCollector::writeOutput(const PerLevelOutput& output) const
 			switch (solution.m_solutionType) {
 				case MAZEZAM_SOLUTION_FEWEST_PUSHES:
 					if (m_solutionTypeFlags && solution.m_solutionType)
-						m_outStream << "Solution(Pushes): " << solution.m_solution << "\n";
+						m_outStream << "Solution(Pushes): " << solution.m_solution.getPath() << "\n";
 					break;
 				case MAZEZAM_SOLUTION_FEWEST_MOVES:
-					m_outStream << "Solution(Moves): " << solution.m_solution << "\n";
+					m_outStream << "Solution(Moves): " << solution.m_solution.getPath() << "\n";
+					break;
+				case MAZEZAM_SOLUTION_FEWEST_PUSHES_THEN_MOVES:
+					m_outStream << "Solution(PushesThenMoves): " << solution.m_solution.getPath() << "\n";
 					break;
 				case MAZEZAM_SOLUTION_FASTEST:
-					m_outStream << "Solution: " << solution.m_solution << "\n";
+					m_outStream << "Solution: " << solution.m_solution.getPath() << "\n";
 					break;
 				default:
 					assert(false);
@@ -24,15 +24,25 @@ class OutstreamSolutionCollector : public SolutionCollector
 public:
 	OutstreamSolutionCollector(std::ostream& os, unsigned int solutionTypeFlags, bool copyMode);
 	
+	/*!
+	 * Write the statistics of each search to statsStream, or not at all if it is NULL (the default).
+	 */
+	void setStatsStream(std::ostream* statsStream);
+	
 	// SolutionCollector interface.
 	virtual void collectLevelNumber(unsigned int levelNumber);
-	virtual void collectSolution(unsigned int levelNumber, MazezamSolutionType solutionType, const MazezamSolutionSource& source);
-	virtual void collectRating(unsigned int levelNumber, MazezamRating rating, unsigned int numPushes);
+	virtual void collectSolution(unsigned int levelNumber, MazezamSolutionType solutionType, const MazezamSolution& solution);
+	virtual void collectRating(unsigned int levelNumber, MazezamRating rating);
+	virtual void collectSolverStats(unsigned int levelNumber, MazezamSolutionType solutionType, const mzmslv::SolverStats& stats);
 private:
 	/*!
 	 * The stream to which this object is writing.
 	 */
 	std::ostream& m_outStream;
+	/*!
+	 * The stream to which the statistics of searches are written, or NULL.
+	 */
+	std::ostream* m_statsStream;
 	/*!
 	 * A bitfield indicating the type of solutions which are desired.
 	 */
@@ -47,11 +57,11 @@ private:
 	 */
 	std::list<unsigned int> m_levelNumbers;
 	/*!
-	 * A solution.
+	 * A solution, whose moves are found when it is written.
 	 */
 	struct Solution {
 		MazezamSolutionType m_solutionType;
-		mzm_path m_solution;
+		MazezamSolution m_solution;
 	};
 	/*!
 	 * The data being held for a level which hasn't been finished yet.
@@ -37,7 +37,7 @@ bool Selection::isSelected(mzm_coord y, mzm_coord x) const
 	assert(y < MAX_MAZEZAM_HEIGHT);
 	assert(x >= 0);
 	assert(x < MAX_MAZEZAM_WIDTH);
-	return m_row[y] & (1 << x);
+	return m_row[y] & ((mzm_row) 1 << x);
 }
 
 void Selection::select(mzm_coord y, mzm_coord x)
@@ -46,7 +46,7 @@ void Selection::select(mzm_coord y, mzm_coord x)
 	assert(y < MAX_MAZEZAM_HEIGHT);
 	assert(x >= 0);
 	assert(x < MAX_MAZEZAM_WIDTH);
-	m_row[y] |= (1 << x);
+	m_row[y] |= ((mzm_row) 1 << x);
 }
 
 void Selection::unselect(mzm_coord y, mzm_coord x)
@@ -55,7 +55,7 @@ void Selection::unselect(mzm_coord y, mzm_coord x)
 	assert(y < MAX_MAZEZAM_HEIGHT);
 	assert(x >= 0);
 	assert(x < MAX_MAZEZAM_WIDTH);
-	m_row[y] &= ~(1 << x);
+	m_row[y] &= ~((mzm_row) 1 << x);
 }
 
 void Selection::selectAll()
@@ -72,7 +72,7 @@ void Selection::selectRectangle(mzm_coord y, mzm_coord x, mzm_coord h, mzm_coord
 	assert(w >= 0);
 	assert(x + w < MAX_MAZEZAM_WIDTH);
 	for (int i = 0; i < h; ++i)
-		m_row[y+i] |= (((1 << (w + 1)) - 1) << x);
+		m_row[y+i] |= ((((mzm_row) 1 << (w + 1)) - 1) << x);
 }
 
 void Selection::clear()
@@ -92,7 +92,7 @@ void Selection::resize(mzm_coord newHeight, mzm_coord newWidth)
 		row = new mzm_row[newHeight];
 	}
 	for (int i = 0; i < std::min(m_height, newHeight); ++i) {
-		row[i] = m_row[i] & ((1 << (std::min(m_width, newWidth))) - 1 );
+		row[i] = m_row[i] & (((mzm_row) 1 << (std::min(m_width, newWidth))) - 1 );
 	}
 	if (m_height != newHeight) {
 		for (int i = m_height; i < newHeight; ++i)
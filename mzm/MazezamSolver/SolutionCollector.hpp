@@ -13,7 +13,11 @@
 #include <mzm/Mazezam/TypesAndConstants.hpp>
 #include <mzm/MazezamSolver/MazezamSolutionType.hpp>
 #include <mzm/MazezamSolver/MazezamRatingType.hpp>
-#include <mzm/MazezamSolver/MazezamSolutionSource.hpp>
+#include <mzm/MazezamSolver/MazezamSolution.hpp>
+
+namespace mzmslv {
+class SolverStats;
+}
 
 namespace mzm {
 
@@ -30,9 +34,10 @@ public:
 	 */
 	virtual void collectLevelNumber(unsigned int levelNumber) {}
 	/*!
-	 * Inform the collector about a solution to the mazezam.
+	 * Inform the collector about a solution to the mazezam. Collectors which only
+	 * need the moves of the solution later can keep a copy of it.
 	 */
-	virtual void collectSolution(unsigned int levelNumber, MazezamSolutionType solutionType, const MazezamSolutionSource& source) = 0;
+	virtual void collectSolution(unsigned int levelNumber, MazezamSolutionType solutionType, const MazezamSolution& solution) = 0;
 	/*!
 	 * Inform the collector that a level has been assigned the rating.
 	 */
@@ -45,10 +50,19 @@ public:
 	 * Inform the collector of the minimum number of moves required to solve the level.
 	 */
 	virtual void collectNumMoves(unsigned int levelNumber, unsigned int numMoves) {}
+	/*!
+	 * Inform the collector of a number of moves with which the level can be solved.
+	 * It is quick to find, so it comes before the minimum, which it may be more than.
+	 */
+	virtual void collectMovesBound(unsigned int levelNumber, unsigned int numMoves) {}
 	/*!
 	 * Informs the collector that an improved version of the level has been obtained.
 	 */
 	virtual void collectImprovement(unsigned int levelNumber, const MazezamData& level) {}
+	/*!
+	 * Inform the collector of the statistics of the search for a solution.
+	 */
+	virtual void collectSolverStats(unsigned int levelNumber, MazezamSolutionType solutionType, const mzmslv::SolverStats& stats) {}
 	/*!
 	 * Virtual destructor.
 	 */
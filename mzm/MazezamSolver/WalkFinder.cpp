@@ -0,0 +1,97 @@
+/* ***************************************************************************
+ * WalkFinder.cpp
+ * Copyright (c) 2008, 2010, 2020 Malcolm Tyrrell.
+ * All rights reserved. This program and the accompanying materials
+ * are made available under the terms of the GNU Public License v3.0
+ * which accompanies this distribution, and is available at
+ * http://gplv3.fsf.org/
+ * ***************************************************************************/
+
+#include <cassert>
+
+#include <mzm/MazezamSolver/WalkFinder.hpp>
+
+namespace mzm {
+
+template<class R>
+WalkFinder<R>::WalkFinder(const MazezamData& level)
+: m_level(level)
+, m_space(level.getHeight())
+, m_reached(level.getHeight())
+{
+}
+
+template<class R>
+bool WalkFinder<R>::addWalk(const mzm_coord* inset, mzm_path& p, mzm_coord& x, mzm_coord& y, mzm_coord tx, mzm_coord ty)
+{
+	const int height = m_level.getHeight();
+	const int width = m_level.getWidth();
+	assert ((x >= 0) && (x < width) && (y >= 0) && (y < height));
+	assert ((tx >= 0) && (tx < width) && (ty >= 0) && (ty < height));
+	const R full = ((R) 1 << width) - 1;
+	for (int i = 0; i < height; ++i)
+		m_space[i] = ~(((R) m_level.getRow(i)) >> inset[i]) & full;
+	const R target = (R) 1 << (width - 1 - tx);
+	if (!(m_space[ty] & target))
+		return false;
+
+	// Spread out a step at a time until the target is reached.
+	m_layers.assign(height, 0);
+	m_layers[y] = (R) 1 << (width - 1 - x);
+	assert (m_space[y] & m_layers[y]);
+	for (int i = 0; i < height; ++i)
+		m_reached[i] = m_layers[i];
+	int steps = 0;
+	while (!(m_layers[(steps * height) + ty] & target)) {
+		m_layers.resize((steps + 2) * height);
+		const R* last = &m_layers[steps * height];
+		R* next = &m_layers[(steps + 1) * height];
+		bool spread = false;
+		for (int i = 0; i < height; ++i) {
+			R r = last[i] | (last[i] << 1) | (last[i] >> 1);
+			if (i > 0)
+				r |= last[i - 1];
+			if (i < height - 1)
+				r |= last[i + 1];
+			r &= m_space[i] & ~m_reached[i];
+			next[i] = r;
+			m_reached[i] |= r;
+			spread |= (r != 0);
+		}
+		if (!spread)
+			return false;
+		++steps;
+	}
+
+	// Step back from the target, to a position reached one step earlier each time.
+	const unsigned int start = p.size();
+	p.resize(start + steps);
+	R xxx = target;
+	mzm_coord yy = ty;
+	for (int k = steps; k > 0; --k) {
+		const R* previous = &m_layers[(k - 1) * height];
+		if (previous[yy] & (xxx << 1)) {
+			p.set(start + k - 1, DIR_EAST);
+			xxx <<= 1;
+		} else if (previous[yy] & (xxx >> 1)) {
+			p.set(start + k - 1, DIR_WEST);
+			xxx >>= 1;
+		} else if ((yy > 0) && (previous[yy - 1] & xxx)) {
+			p.set(start + k - 1, DIR_SOUTH);
+			--yy;
+		} else {
+			assert ((yy < height - 1) && (previous[yy + 1] & xxx));
+			p.set(start + k - 1, DIR_NORTH);
+			++yy;
+		}
+	}
+	x = tx;
+	y = ty;
+	return true;
+}
+
+template class WalkFinder<unsigned int>;
+template class WalkFinder<unsigned long long>;
+template class WalkFinder<mzm_row>;
+
+} // namespace mzm
@@ -0,0 +1,80 @@
+/* ***************************************************************************
+ * WalkFinder.hpp
+ * Copyright (c) 2008, 2010, 2020 Malcolm Tyrrell.
+ * All rights reserved. This program and the accompanying materials
+ * are made available under the terms of the GNU Public License v3.0
+ * which accompanies this distribution, and is available at
+ * http://gplv3.fsf.org/
+ * ***************************************************************************/
+
+#ifndef WALKFINDER_H_
+#define WALKFINDER_H_
+
+#include <vector>
+
+#include <mzm/Mazezam/MazezamData.hpp>
+#include <mzm/Mazezam/PackedPath.hpp>
+
+namespace mzm {
+
+/*!
+ * Finds the shortest walks from one player position to another without
+ * pushing rows.
+ * The positions reached after each number of steps are found a row at a time,
+ * as masks of type R (which must be able to hold the rows of the level), and
+ * kept, so a walk can be found by stepping back through them from the target.
+ * A finder can be used for several walks, which reuses its storage.
+ */
+template<class R>
+class WalkFinder
+{
+public:
+	/*!
+	 * Constructor.
+	 * \param level the underlying level.
+	 */
+	WalkFinder(const MazezamData& level);
+
+	/*!
+	 * Add the moves of a shortest walk from (x,y) to (tx,ty) to a path.
+	 * \param inset the insets of the rows.
+	 * \param p the path to which moves are added.
+	 * \param x the x coord at which to start, and the x coord which was reached.
+	 * \param y the y coord at which to start, and the y coord which was reached.
+	 * \param tx the target x position.
+	 * \param ty the target y position.
+	 * \return false, leaving p, x and y unchanged, if the target cannot be reached.
+	 */
+	bool addWalk(const mzm_coord* inset, mzm_path& p, mzm_coord& x, mzm_coord& y, mzm_coord tx, mzm_coord ty);
+private:
+	/*!
+	 * The underlying level.
+	 */
+	const MazezamData& m_level;
+
+	/*!
+	 * The positions which aren't occupied by blocks.
+	 */
+	std::vector<R> m_space;
+
+	/*!
+	 * The positions reached so far.
+	 */
+	std::vector<R> m_reached;
+
+	/*!
+	 * The positions first reached after each number of steps, one row per
+	 * row of the level.
+	 */
+	std::vector<R> m_layers;
+
+	/*!
+	 * Copying private and unimplemented.
+	 */
+	WalkFinder(const WalkFinder&);
+	WalkFinder& operator=(const WalkFinder&);
+};
+
+} // namespace mzm
+
+#endif /*WALKFINDER_H_*/
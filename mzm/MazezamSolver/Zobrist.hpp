@@ -0,0 +1,80 @@
+/* ***************************************************************************
+ * Zobrist.hpp
+ * Copyright (c) 2008, 2010, 2020 Malcolm Tyrrell.
+ * All rights reserved. This program and the accompanying materials
+ * are made available under the terms of the GNU Public License v3.0
+ * which accompanies this distribution, and is available at
+ * http://gplv3.fsf.org/
+ * ***************************************************************************/
+
+#ifndef ZOBRIST_H_
+#define ZOBRIST_H_
+
+#include <mzm/Mazezam/TypesAndConstants.hpp>
+
+namespace mzm {
+
+/*!
+ * A hash of a configuration.
+ */
+typedef unsigned long long mzm_hash;
+
+/*!
+ * Keys for Zobrist hashing of configurations: the hash of a configuration is
+ * the xor of the keys of its features, so when a move or push changes one
+ * feature, the hash can be updated by xoring out the old key and xoring in
+ * the new one.
+ * Rather than being kept in tables, the keys are generated on demand by
+ * scrambling the feature with a mixing function, which is cheap and avoids
+ * tables of several tens of kilobytes.
+ */
+class Zobrist
+{
+public:
+	/*!
+	 * The key for row y having the given inset.
+	 */
+	static inline mzm_hash getInsetKey(mzm_coord y, mzm_coord inset) {
+		return mix(INSET_SEED + (((mzm_hash) (unsigned char) y) << 8) + (unsigned char) inset);
+	}
+	/*!
+	 * The key for the player being at (xx, y).
+	 */
+	static inline mzm_hash getPositionKey(mzm_coord xx, mzm_coord y) {
+		return mix(POSITION_SEED + (((mzm_hash) (unsigned char) y) << 8) + (unsigned char) xx);
+	}
+	/*!
+	 * The key for the player being in the given component of the zones.
+	 */
+	static inline mzm_hash getComponentKey(unsigned int component) {
+		return mix(COMPONENT_SEED + component);
+	}
+	/*!
+	 * The xor of the keys of all the insets.
+	 */
+	static mzm_hash getInsetsHash(mzm_coord height, const mzm_coord* inset) {
+		mzm_hash hash = 0;
+		for (mzm_coord y = 0; y < height; ++y)
+			hash ^= getInsetKey(y, inset[y]);
+		return hash;
+	}
+private:
+	/*!
+	 * The seeds which keep the keys of different kinds of features apart.
+	 */
+	static const mzm_hash INSET_SEED = 0x9e3779b97f4a7c15ULL;
+	static const mzm_hash POSITION_SEED = 0xc2b2ae3d27d4eb4fULL;
+	static const mzm_hash COMPONENT_SEED = 0x165667b19e3779f9ULL;
+	/*!
+	 * Scramble a value (the finalizer of splitmix64).
+	 */
+	static inline mzm_hash mix(mzm_hash z) {
+		z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+		z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+		return z ^ (z >> 31);
+	}
+};
+
+} // namespace mzm
+
+#endif /*ZOBRIST_H_*/
@@ -0,0 +1,106 @@
+/* ***************************************************************************
+ * ZoneCache.cpp
+ * Copyright (c) 2008, 2010, 2020 Malcolm Tyrrell.
+ * All rights reserved. This program and the accompanying materials
+ * are made available under the terms of the GNU Public License v3.0
+ * which accompanies this distribution, and is available at
+ * http://gplv3.fsf.org/
+ * ***************************************************************************/
+
+#include <cassert>
+
+#include <mzm/MazezamSolver/ZoneCache.hpp>
+#include <mzmslv/MemoryAccount.hpp>
+
+namespace mzm {
+
+template<class R>
+ZoneCache<R>::ZoneCache(const MazezamData& level, unsigned int capacity)
+: m_level(level)
+, m_capacity(capacity)
+, m_count(0)
+, m_newest(0)
+, m_oldest(0)
+{
+	assert (capacity > 0);
+	unsigned int buckets = 1;
+	while (buckets < capacity)
+		buckets <<= 1;
+	m_buckets.resize(buckets, 0);
+}
+
+template<class R>
+ZoneCache<R>::~ZoneCache()
+{
+	while (m_oldest) {
+		ZoneLabelling<R>* labelling = m_oldest;
+		m_oldest = labelling->m_newer;
+		mzmslv::MemoryAccount::freed(mzmslv::SolverStats::KIND_ZONES, labelling->getSize());
+		delete labelling;
+	}
+}
+
+template<class R>
+void ZoneCache<R>::unlink(ZoneLabelling<R>* labelling)
+{
+	if (labelling->m_newer)
+		labelling->m_newer->m_older = labelling->m_older;
+	else
+		m_newest = labelling->m_older;
+	if (labelling->m_older)
+		labelling->m_older->m_newer = labelling->m_newer;
+	else
+		m_oldest = labelling->m_newer;
+	ZoneLabelling<R>** l = &getBucket(labelling->getInsetsId());
+	while (*l != labelling)
+		l = &(*l)->m_nextInBucket;
+	*l = labelling->m_nextInBucket;
+}
+
+template<class R>
+void ZoneCache<R>::link(ZoneLabelling<R>* labelling)
+{
+	labelling->m_newer = 0;
+	labelling->m_older = m_newest;
+	if (m_newest)
+		m_newest->m_newer = labelling;
+	else
+		m_oldest = labelling;
+	m_newest = labelling;
+	ZoneLabelling<R>*& bucket = getBucket(labelling->getInsetsId());
+	labelling->m_nextInBucket = bucket;
+	bucket = labelling;
+}
+
+template<class R>
+const ZoneLabelling<R>& ZoneCache<R>::getLabelling(unsigned int insetsId, const mzm_coord* inset)
+{
+	for (ZoneLabelling<R>* labelling = getBucket(insetsId); labelling; labelling = labelling->m_nextInBucket) {
+		if (labelling->getInsetsId() == insetsId) {
+			if (labelling != m_newest) {
+				unlink(labelling);
+				link(labelling);
+			}
+			return *labelling;
+		}
+	}
+	ZoneLabelling<R>* labelling;
+	if (m_count < m_capacity) {
+		labelling = new ZoneLabelling<R>(m_level);
+		++m_count;
+	} else {
+		labelling = m_oldest;
+		unlink(labelling);
+		mzmslv::MemoryAccount::freed(mzmslv::SolverStats::KIND_ZONES, labelling->getSize());
+	}
+	labelling->label(insetsId, inset, m_scratch);
+	mzmslv::MemoryAccount::allocated(mzmslv::SolverStats::KIND_ZONES, labelling->getSize());
+	link(labelling);
+	return *labelling;
+}
+
+template class ZoneCache<unsigned int>;
+template class ZoneCache<unsigned long long>;
+template class ZoneCache<mzm_row>;
+
+} // namespace mzm
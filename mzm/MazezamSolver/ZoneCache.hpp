@@ -0,0 +1,113 @@
+/* ***************************************************************************
+ * ZoneCache.hpp
+ * Copyright (c) 2008, 2010, 2020 Malcolm Tyrrell.
+ * All rights reserved. This program and the accompanying materials
+ * are made available under the terms of the GNU Public License v3.0
+ * which accompanies this distribution, and is available at
+ * http://gplv3.fsf.org/
+ * ***************************************************************************/
+
+#ifndef ZONECACHE_H_
+#define ZONECACHE_H_
+
+#include <vector>
+
+#include <mzm/MazezamSolver/ZoneLabelling.hpp>
+
+namespace mzm {
+
+/*!
+ * The zone labellings of the most recently used insets of an InsetStore.
+ * The labellings are found through a hash table on the numbers of their insets,
+ * and the least recently used one is relabelled when a labelling is needed
+ * for insets which aren't in the cache, so a full cache allocates nothing.
+ */
+template<class R>
+class ZoneCache
+{
+public:
+	/*!
+	 * Constructor.
+	 * \param level the underlying level.
+	 * \param capacity the number of labellings kept.
+	 */
+	ZoneCache(const MazezamData& level, unsigned int capacity = DEFAULT_CAPACITY);
+
+	/*!
+	 * Destructor.
+	 */
+	~ZoneCache();
+
+	/*!
+	 * Get the labelling of the given insets, labelling them if they aren't in the cache.
+	 * The labelling remains valid until the next call, which may relabel it.
+	 * \param insetsId the number of the insets in their InsetStore.
+	 * \param inset the insets.
+	 */
+	const ZoneLabelling<R>& getLabelling(unsigned int insetsId, const mzm_coord* inset);
+
+	/*!
+	 * The number of labellings kept by default.
+	 */
+	static const unsigned int DEFAULT_CAPACITY = 64;
+private:
+	/*!
+	 * Unlink a labelling from the list of labellings and from its bucket.
+	 */
+	void unlink(ZoneLabelling<R>* labelling);
+
+	/*!
+	 * Link a labelling into the front of the list of labellings and into its bucket.
+	 */
+	void link(ZoneLabelling<R>* labelling);
+
+	/*!
+	 * The bucket of the insets with the given number.
+	 */
+	inline ZoneLabelling<R>*& getBucket(unsigned int insetsId) {
+		return m_buckets[insetsId & (m_buckets.size() - 1)];
+	}
+
+	/*!
+	 * The underlying level.
+	 */
+	const MazezamData& m_level;
+
+	/*!
+	 * The number of labellings kept.
+	 */
+	unsigned int m_capacity;
+
+	/*!
+	 * The number of labellings.
+	 */
+	unsigned int m_count;
+
+	/*!
+	 * The most and least recently used labellings, which are at the ends of a
+	 * list linked through the labellings.
+	 */
+	ZoneLabelling<R>* m_newest;
+	ZoneLabelling<R>* m_oldest;
+
+	/*!
+	 * The hash table, whose size is a power of two. Each bucket is a list linked
+	 * through the labellings.
+	 */
+	std::vector<ZoneLabelling<R>*> m_buckets;
+
+	/*!
+	 * Storage for labelling in.
+	 */
+	std::vector<R> m_scratch;
+
+	/*!
+	 * Copying private and unimplemented.
+	 */
+	ZoneCache(const ZoneCache&);
+	ZoneCache& operator=(const ZoneCache&);
+};
+
+} // namespace mzm
+
+#endif /*ZONECACHE_H_*/
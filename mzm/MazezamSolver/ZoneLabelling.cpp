@@ -0,0 +1,274 @@
+/* ***************************************************************************
+ * ZoneLabelling.cpp
+ * Copyright (c) 2008, 2010, 2020 Malcolm Tyrrell.
+ * All rights reserved. This program and the accompanying materials
+ * are made available under the terms of the GNU Public License v3.0
+ * which accompanies this distribution, and is available at
+ * http://gplv3.fsf.org/
+ * ***************************************************************************/
+
+#include <cassert>
+#include <climits>
+
+#include <mzm/MazezamSolver/ZoneLabelling.hpp>
+#include <mzmslv/PerfCounters.hpp>
+
+namespace mzm {
+
+/*!
+ * Extend the bits of seeds along the runs of set bits of space which contain them,
+ * in both directions. The bits of seeds must be set in space.
+ * This uses occluded fills, which double the distance covered at each step,
+ * so it takes log2 of the number of bits in R steps in each direction.
+ */
+template<class R>
+static inline R fillRuns(R seeds, R space)
+{
+	R left = seeds;
+	R leftSpace = space;
+	R right = seeds;
+	R rightSpace = space;
+	for (unsigned int shift = 1; shift < sizeof(R) * CHAR_BIT; shift <<= 1) {
+		left |= (left << shift) & leftSpace;
+		leftSpace &= leftSpace << shift;
+		right |= (right >> shift) & rightSpace;
+		rightSpace &= rightSpace >> shift;
+	}
+	return left | right;
+}
+
+/*!
+ * Spread a row of a zone into the positions of space adjacent to the positions of
+ * from (a neighbouring row of the zone), and the positions connected to them.
+ * \return true if the row of the zone changed.
+ */
+template<class R>
+static inline bool spreadRow(R& zone, R from, R space)
+{
+	const R seeds = from & space & ~zone;
+	if (!seeds)
+		return false;
+	zone |= fillRuns(seeds, space);
+	return true;
+}
+
+/*!
+ * Spread a zone from row y, which is the only row which has changed, to every
+ * position connected to it.
+ * The rows which have changed run from top to bottom. The zone is swept down and up
+ * through them (and the rows next to them) until it stops spreading. If row y was
+ * the zone's only non-empty row, top and bottom are then the rows the zone reaches.
+ */
+template<class R>
+static void spreadZone(R* zone, const R* space, int height, int y, int& top, int& bottom)
+{
+	top = y;
+	bottom = y;
+	bool changed = true;
+	while (changed) {
+		changed = false;
+		for (int i = top + 1; (i < height) && (i <= bottom + 1); ++i) {
+			if (spreadRow(zone[i], zone[i - 1], space[i])) {
+				changed = true;
+				if (i > bottom)
+					bottom = i;
+			}
+		}
+		for (int i = bottom - 1; (i >= 0) && (i >= top - 1); --i) {
+			if (spreadRow(zone[i], zone[i + 1], space[i])) {
+				changed = true;
+				if (i < top)
+					top = i;
+			}
+		}
+	}
+}
+
+/*!
+ * The number of the component whose first position is on row y, and is the
+ * rightmost position of firstRow.
+ */
+template<class R>
+static inline unsigned int componentNumber(R firstRow, int y)
+{
+	assert (firstRow);
+	unsigned int x = 0;
+	while (!(firstRow & 0xff)) {
+		firstRow >>= 8;
+		x += 8;
+	}
+	while (!(firstRow & 1)) {
+		firstRow >>= 1;
+		++x;
+	}
+	return (y * sizeof(R) * CHAR_BIT) + x;
+}
+
+/*!
+ * Move positions one place along row y towards the rest of their runs, when they
+ * are positions at the end of runs which a push filled with blocks.
+ */
+template<class R>
+static inline R towardsRun(R positions, bool wasLeft)
+{
+	return wasLeft ? (positions << 1) : (positions >> 1);
+}
+
+/*!
+ * The inverse of towardsRun, for positions which didn't fall off the end of the row.
+ */
+template<class R>
+static inline R awayFromRun(R positions, bool wasLeft)
+{
+	return wasLeft ? (positions >> 1) : (positions << 1);
+}
+
+template<class R>
+ZoneLabelling<R>::ZoneLabelling(const MazezamData& level)
+: m_level(level)
+, m_insetsId(~0U)
+, m_goalComponent(NO_COMPONENT)
+, m_size(0)
+, m_newer(0)
+, m_older(0)
+, m_nextInBucket(0)
+{
+}
+
+template<class R>
+void ZoneLabelling<R>::label(unsigned int insetsId, const mzm_coord* inset, std::vector<R>& scratch)
+{
+	mzmslv::PerfCounters::Scope scope(mzmslv::SolverStats::PHASE_ZONES);
+	const int height = m_level.getHeight();
+	assert (m_level.checkInsets(inset));
+	m_insetsId = insetsId;
+	m_components.clear();
+	m_rows.clear();
+
+	const R full = ((R) 1 << m_level.getWidth()) - 1;
+	scratch.resize(3 * height);
+	R* space = &scratch[0];
+	R* unlabelled = space + height;
+	R* zone = unlabelled + height;
+	for (int i = 0; i < height; ++i) {
+		space[i] = ~(((R) m_level.getRow(i)) >> inset[i]) & full;
+		unlabelled[i] = space[i];
+		zone[i] = 0;
+	}
+
+	// Every zone first reaches the row on which it has its first unlabelled position,
+	// so it is stored from that row down.
+	for (int y = 0; y < height; ++y) {
+		while (unlabelled[y]) {
+			const R seed = unlabelled[y] & (~unlabelled[y] + 1);
+			zone[y] = fillRuns(seed, space[y]);
+			int top, bottom;
+			spreadZone(zone, space, height, y, top, bottom);
+			assert (top == y);
+			Component c;
+			c.m_number = componentNumber(zone[y], y);
+			c.m_top = top;
+			c.m_bottom = bottom;
+			c.m_offset = m_rows.size();
+			m_components.push_back(c);
+			for (int i = top; i <= bottom; ++i) {
+				m_rows.push_back(zone[i]);
+				unlabelled[i] &= ~zone[i];
+				zone[i] = 0;
+			}
+		}
+	}
+	m_goalComponent = getComponent(1, m_level.getFinish());
+	m_size = sizeof(ZoneLabelling)
+		+ (m_components.capacity() * sizeof(Component)) + (m_rows.capacity() * sizeof(R));
+}
+
+template<class R>
+unsigned int ZoneLabelling<R>::getComponent(R xxx, mzm_coord y) const
+{
+	// Components are in order of their top rows.
+	for (unsigned int c = 0; (c < m_components.size()) && (m_components[c].m_top <= y); ++c) {
+		const Component& component = m_components[c];
+		if ((y <= component.m_bottom) && (m_rows[component.m_offset + y - component.m_top] & xxx))
+			return component.m_number;
+	}
+	return NO_COMPONENT;
+}
+
+template<class R>
+const typename ZoneLabelling<R>::Component& ZoneLabelling<R>::findComponent(unsigned int component) const
+{
+	// Components are in order of their numbers.
+	assert (!m_components.empty());
+	unsigned int low = 0;
+	unsigned int high = m_components.size();
+	while (high - low > 1) {
+		const unsigned int middle = (low + high) / 2;
+		if (m_components[middle].m_number <= component)
+			low = middle;
+		else
+			high = middle;
+	}
+	assert (m_components[low].m_number == component);
+	return m_components[low];
+}
+
+template<class R>
+void ZoneLabelling<R>::getZone(unsigned int component, R* zone) const
+{
+	const Component& c = findComponent(component);
+	for (int i = 0; i < m_level.getHeight(); ++i)
+		zone[i] = ((i < c.m_top) || (i > c.m_bottom)) ? 0 : m_rows[c.m_offset + i - c.m_top];
+}
+
+template<class R>
+unsigned int ZoneLabelling<R>::getComponentNumber(const R* zone)
+{
+	int y = 0;
+	while (!zone[y])
+		++y;
+	return componentNumber(zone[y], y);
+}
+
+template<class R>
+bool ZoneLabelling<R>::updateZone(R* zone, const R* parentZone, const R* space, int height, R xxx, mzm_coord y, bool wasLeft)
+{
+	// The positions of the parent's zone on row y which the push filled with blocks.
+	const R lost = parentZone[y] & ~space[y];
+	// The rows above and below row y of the parent's zone.
+	const R above = (y > 0) ? parentZone[y - 1] : 0;
+	const R below = (y < height - 1) ? parentZone[y + 1] : 0;
+	// The positions on row y which are in the zone both before and after the push.
+	// The player's position counts, as it's next to where the player pushed from.
+	const R kept = (parentZone[y] | xxx) & space[y];
+
+	// Only row y changed, so the parent's zone minus the lost positions is still
+	// connected, and connected to the player, unless a path through a lost position
+	// was cut off. Each lost position is at the end of a run, so a path can only have
+	// been cut off if it left row y through the lost position, and can't instead
+	// leave through the position's neighbour in the run.
+	const R cutAbove = lost & above;
+	const R cutBelow = lost & below;
+	const R aroundAbove = towardsRun(cutAbove, wasLeft);
+	const R aroundBelow = towardsRun(cutBelow, wasLeft);
+	if ((awayFromRun(aroundAbove, wasLeft) != cutAbove) || ((aroundAbove & above & kept) != aroundAbove)
+		|| (awayFromRun(aroundBelow, wasLeft) != cutBelow) || ((aroundBelow & below & kept) != aroundBelow))
+		return false;
+
+	mzmslv::PerfCounters::Scope scope(mzmslv::SolverStats::PHASE_ZONES);
+	for (int i = 0; i < height; ++i)
+		zone[i] = parentZone[i];
+	// The zone can only have grown through row y, so refill that row from the player,
+	// the rest of the parent's zone on it, and the parent's zone on the rows next to it,
+	// and then let it spread.
+	zone[y] = fillRuns(xxx | ((parentZone[y] | above | below) & space[y]), space[y]);
+	int top, bottom;
+	spreadZone(zone, space, height, y, top, bottom);
+	return true;
+}
+
+template class ZoneLabelling<unsigned int>;
+template class ZoneLabelling<unsigned long long>;
+template class ZoneLabelling<mzm_row>;
+
+} // namespace mzm
@@ -0,0 +1,184 @@
+/* ***************************************************************************
+ * ZoneLabelling.hpp
+ * Copyright (c) 2008, 2010, 2020 Malcolm Tyrrell.
+ * All rights reserved. This program and the accompanying materials
+ * are made available under the terms of the GNU Public License v3.0
+ * which accompanies this distribution, and is available at
+ * http://gplv3.fsf.org/
+ * ***************************************************************************/
+
+#ifndef ZONELABELLING_H_
+#define ZONELABELLING_H_
+
+#include <vector>
+
+#include <mzm/Mazezam/MazezamData.hpp>
+
+namespace mzm {
+
+template<class R> class ZoneCache;
+
+/*!
+ * The zones of a level with a given set of insets: the connected components
+ * of the positions which aren't occupied by blocks.
+ * Every configuration with those insets has one of these zones, so they can
+ * be shared by all of them.
+ * Components are numbered by their first position (top to bottom, and right to
+ * left along rows), so labelling the same insets twice numbers the components
+ * the same way, and a zone found some other way can be given its number with
+ * getComponentNumber.
+ * A labelling can be relabelled with other insets, which reuses its storage.
+ * The rows of the zones are of type R, which must be able to hold the rows of the level.
+ */
+template<class R>
+class ZoneLabelling
+{
+public:
+	/*!
+	 * Constructor. The labelling is empty until label is called.
+	 * \param level the underlying level.
+	 */
+	ZoneLabelling(const MazezamData& level);
+
+	/*!
+	 * Label the zones of the level with the given insets.
+	 * \param insetsId the number of the insets in their InsetStore.
+	 * \param inset the insets.
+	 * \param scratch storage to work in, which can be reused between labellings.
+	 */
+	void label(unsigned int insetsId, const mzm_coord* inset, std::vector<R>& scratch);
+
+	/*!
+	 * The number of the insets in their InsetStore.
+	 */
+	inline unsigned int getInsetsId() const { return m_insetsId; }
+
+	/*!
+	 * Returns the component containing a position.
+	 * \param xxx the position's x coord, represented in the form (1 << x).
+	 * \param y the position's y coord.
+	 * \return the component, or NO_COMPONENT if the position is occupied by a block.
+	 */
+	unsigned int getComponent(R xxx, mzm_coord y) const;
+
+	/*!
+	 * Returns the component containing the rightmost position of the finishing row,
+	 * or NO_COMPONENT if it's occupied by a block.
+	 */
+	inline unsigned int getGoalComponent() const { return m_goalComponent; }
+
+	/*!
+	 * The yth row of a component's zone.
+	 */
+	inline R getZoneRow(unsigned int component, mzm_coord y) const {
+		const Component& c = findComponent(component);
+		return ((y < c.m_top) || (y > c.m_bottom)) ? 0 : m_rows[c.m_offset + y - c.m_top];
+	}
+
+	/*!
+	 * Copy the rows of a component's zone.
+	 * \param zone where to copy them, which must have a row for each row of the level.
+	 */
+	void getZone(unsigned int component, R* zone) const;
+
+	/*!
+	 * Returns the number of the component with the given zone.
+	 * \param zone the rows of the zone, one for each row of the level.
+	 */
+	static unsigned int getComponentNumber(const R* zone);
+
+	/*!
+	 * Find the zone after a push from the zone before it, where that's cheap.
+	 * A push only changes one row, so unless it cut a path through the row, the
+	 * zone after it is the zone before it, spread from the pushed row.
+	 * \param zone where to put the zone after the push, one row for each row of the level.
+	 * \param parentZone the zone before the push, which contains the position pushed from.
+	 * \param space the positions which aren't occupied by blocks after the push.
+	 * \param height the height of the level.
+	 * \param xxx the player's x position after the push, represented in the form (1 << x).
+	 * \param y the row which was pushed.
+	 * \param wasLeft if the push was left or right.
+	 * \return false if the push may have split the zone, in which case zone is
+	 * unchanged and the zone must be found by labelling.
+	 */
+	static bool updateZone(R* zone, const R* parentZone, const R* space, int height, R xxx, mzm_coord y, bool wasLeft);
+
+	/*!
+	 * The number of bytes used by the labelling.
+	 */
+	inline unsigned long getSize() const { return m_size; }
+
+	/*!
+	 * Returned by getComponent for positions which are in no component.
+	 */
+	static const unsigned int NO_COMPONENT = ~0U;
+private:
+	/*!
+	 * A zone, which is stored as the rows of m_rows between the top and
+	 * bottom rows it reaches.
+	 */
+	struct Component {
+		unsigned int m_number;
+		mzm_coord m_top;
+		mzm_coord m_bottom;
+		unsigned int m_offset;
+	};
+
+	/*!
+	 * The component with the given number, which must be in the labelling.
+	 */
+	const Component& findComponent(unsigned int component) const;
+
+	/*!
+	 * The underlying level.
+	 */
+	const MazezamData& m_level;
+
+	/*!
+	 * The number of the insets.
+	 */
+	unsigned int m_insetsId;
+
+	/*!
+	 * The components.
+	 */
+	std::vector<Component> m_components;
+
+	/*!
+	 * The rows of all the components.
+	 */
+	std::vector<R> m_rows;
+
+	/*!
+	 * The component containing the goal.
+	 */
+	unsigned int m_goalComponent;
+
+	/*!
+	 * The number of bytes used by the labelling.
+	 */
+	unsigned long m_size;
+
+	/*!
+	 * The next more and less recently used labellings in a ZoneCache.
+	 */
+	ZoneLabelling* m_newer;
+	ZoneLabelling* m_older;
+
+	/*!
+	 * The next labelling in the same bucket of a ZoneCache.
+	 */
+	ZoneLabelling* m_nextInBucket;
+
+	friend class ZoneCache<R>;
+
+	/*!
+	 * Copying private and unimplemented.
+	 */
+	ZoneLabelling(const ZoneLabelling&);
+	ZoneLabelling& operator=(const ZoneLabelling&);
+};
+
+} // namespace mzm
+
+#endif /*ZONELABELLING_H_*/
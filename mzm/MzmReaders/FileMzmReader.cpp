@@ -91,7 +91,9 @@ bool FileMzmReader::findNextMazezam(mzm_coord& width)
 		{ERROR, ERROR, ERROR, ERROR, ERROR, ERROR, ERROR}
 	};
 	
-	width = 0;
+	// The length of the wall, which is counted as an int, as it includes the
+	// corners and so can be 2 more than the widest level.
+	int length = 0;
 	
 	// seek the north wall of a mazezam.
 	while (state != FOUND_WALL && m_istream.get(c)) {
@@ -104,8 +106,8 @@ bool FileMzmReader::findNextMazezam(mzm_coord& width)
 				m_ostream << c;
 				break;
 			case SOLID_WALL:
-				errorIf(width >= MAX_MAZEZAM_WIDTH);
-				++width;
+				errorIf(length >= MAX_MAZEZAM_WIDTH + 2);
+				++length;
 				break;
 			case NEW_LINE:
 				++m_lineNumber;
@@ -115,8 +117,8 @@ bool FileMzmReader::findNextMazezam(mzm_coord& width)
 				break;
 		}
 	}
-	// Width is 2 too big.
-	width-=2;
+	// The corners aren't part of the level.
+	width = length - 2;
 	++m_lineNumber;
 	return state == FOUND_WALL; 
 }
@@ -44,6 +44,8 @@ public:
 			 * Write details of the error to a stream.
 			 */
 			virtual void writeToStream (std::ostream& os) { os << m_fileName << ": "; ParseError::writeToStream(os); } 
+			virtual ParseError* clone() const { return new FileParseError(*this); }
+			virtual void raise() const { throw *this; }
 		protected:
 			const std::string m_fileName;
 	};
@@ -0,0 +1,72 @@
+/* ***************************************************************************
+ * FileMzmReaderTest.cpp
+ * Copyright (c) 2008, 2010, 2020 Malcolm Tyrrell.
+ * All rights reserved. This program and the accompanying materials
+ * are made available under the terms of the GNU Public License v3.0
+ * which accompanies this distribution, and is available at
+ * http://gplv3.fsf.org/
+ * ***************************************************************************/
+
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include <mzm/MzmReaders/DummyOStream.hpp>
+#include <mzm/MzmReaders/FileMzmReader.hpp>
+
+using namespace mzm;
+
+namespace {
+
+/*!
+ * A level with the given number of columns between its walls.
+ */
+std::string levelOfWidth(int width)
+{
+	const std::string wall(width + 2, '#');
+	const std::string floor(width, ' ');
+	std::ostringstream os;
+	os << wall << "\n";
+	os << "#" << floor << "#\n";
+	os << "+" << floor << "*\n";
+	os << "#" << floor << "#\n";
+	os << wall << "\n";
+	return os.str();
+}
+
+/*!
+ * Returns true if the reader accepts a level of the given width, and reads
+ * it at that width.
+ */
+bool readsLevelOfWidth(int width)
+{
+	std::istringstream is(levelOfWidth(width));
+	DummyOStream os;
+	FileMzmReader reader(is, "", os);
+	try {
+		if (!reader.next())
+			return false;
+	} catch (MzmReader::ParseError&) {
+		return false;
+	}
+	MazezamData* level = reader.getLevel();
+	const bool widthRead = level->getWidth() == width;
+	delete level;
+	return widthRead;
+}
+
+}
+
+int main()
+{
+	int failures = 0;
+	if (!readsLevelOfWidth(MAX_MAZEZAM_WIDTH)) {
+		std::cerr << "A level " << MAX_MAZEZAM_WIDTH << " wide was rejected" << std::endl;
+		++failures;
+	}
+	if (readsLevelOfWidth(MAX_MAZEZAM_WIDTH + 1)) {
+		std::cerr << "A level " << MAX_MAZEZAM_WIDTH + 1 << " wide was accepted" << std::endl;
+		++failures;
+	}
+	return failures == 0 ? 0 : 1;
+}
@@ -30,8 +30,17 @@ public:
 	class ParseError {
 		public:
 			ParseError (int line) : m_line(line) {};
+			virtual ~ParseError() {}
 			int getLine() const { return m_line; };
 			virtual void writeToStream (std::ostream& os) { os << "Parse error on line " << m_line; } 
+			/*!
+			 * A copy of the error, so it can be thrown again on another thread.
+			 */
+			virtual ParseError* clone() const { return new ParseError(*this); }
+			/*!
+			 * Throw a copy of the error, as its most derived type.
+			 */
+			virtual void raise() const { throw *this; }
 		protected:	
 			const int m_line;
 	};
@@ -0,0 +1,128 @@
+/* ***************************************************************************
+ * Tracer.cpp
+ * Copyright (c) 2008, 2010, 2020 Malcolm Tyrrell.
+ * All rights reserved. This program and the accompanying materials
+ * are made available under the terms of the GNU Public License v3.0
+ * which accompanies this distribution, and is available at
+ * http://gplv3.fsf.org/
+ * ***************************************************************************/
+
+#include "Tracer.hpp"
+
+#include <fstream>
+#include <time.h>
+
+bool Tracer::s_on = false;
+std::string Tracer::s_filename;
+double Tracer::s_startTime = 0;
+std::vector<Tracer::ThreadBuffer*> Tracer::s_buffers;
+pthread_mutex_t Tracer::s_lock = PTHREAD_MUTEX_INITIALIZER;
+__thread Tracer::ThreadBuffer* Tracer::t_buffer = 0;
+
+bool Tracer::start(const std::string& filename)
+{
+	// Check the file can be written now, rather than after the work is done.
+	std::ofstream file(filename.c_str());
+	if (file.fail())
+		return false;
+	s_filename = filename;
+	s_startTime = 0;
+	s_startTime = getTime();
+	s_on = true;
+	return true;
+}
+
+/*!
+ * Write a string as a JSON string literal.
+ */
+static void writeString(std::ostream& os, const char* s)
+{
+	os << '"';
+	for (; *s; ++s) {
+		if ((*s == '"') || (*s == '\\'))
+			os << '\\';
+		os << *s;
+	}
+	os << '"';
+}
+
+void Tracer::stop()
+{
+	if (!s_on)
+		return;
+	s_on = false;
+
+	std::ofstream file(s_filename.c_str());
+	file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+	bool first = true;
+	pthread_mutex_lock(&s_lock);
+	for (std::vector<ThreadBuffer*>::iterator b = s_buffers.begin(); b != s_buffers.end(); ++b) {
+		ThreadBuffer& buffer = **b;
+		if (buffer.m_threadName) {
+			file << (first ? "" : ",\n") << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":" << buffer.m_threadId << ",\"args\":{\"name\":";
+			writeString(file, buffer.m_threadName);
+			file << "}}";
+			first = false;
+		}
+		for (std::vector<Event>::const_iterator e = buffer.m_events.begin(); e != buffer.m_events.end(); ++e) {
+			file << (first ? "" : ",\n") << "{\"ph\":\"" << e->m_phase << "\",\"name\":";
+			writeString(file, e->m_name);
+			if (e->m_category) {
+				file << ",\"cat\":";
+				writeString(file, e->m_category);
+			}
+			file << ",\"ts\":" << std::fixed << e->m_time << ",\"pid\":1,\"tid\":" << buffer.m_threadId;
+			if (e->m_phase == 'C')
+				file << ",\"args\":{\"value\":" << e->m_value << "}";
+			file << "}";
+			first = false;
+		}
+		// Threads may still hold their buffers, so empty them rather than deleting them.
+		buffer.m_events.clear();
+	}
+	pthread_mutex_unlock(&s_lock);
+	file << "\n]}\n";
+}
+
+void Tracer::nameThread(const char* name)
+{
+	if (s_on)
+		getBuffer()->m_threadName = name;
+}
+
+void Tracer::counter(const char* name, long value)
+{
+	if (s_on)
+		record('C', 0, name, value);
+}
+
+void Tracer::record(char phase, const char* category, const char* name, long value)
+{
+	Event event;
+	event.m_category = category;
+	event.m_name = name;
+	event.m_phase = phase;
+	event.m_time = getTime();
+	event.m_value = value;
+	getBuffer()->m_events.push_back(event);
+}
+
+Tracer::ThreadBuffer* Tracer::getBuffer()
+{
+	if (!t_buffer) {
+		t_buffer = new ThreadBuffer;
+		t_buffer->m_threadName = 0;
+		pthread_mutex_lock(&s_lock);
+		t_buffer->m_threadId = s_buffers.size() + 1;
+		s_buffers.push_back(t_buffer);
+		pthread_mutex_unlock(&s_lock);
+	}
+	return t_buffer;
+}
+
+double Tracer::getTime()
+{
+	timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec * 1e6 + now.tv_nsec * 1e-3 - s_startTime;
+}
@@ -0,0 +1,152 @@
+/* ***************************************************************************
+ * Tracer.hpp
+ * Copyright (c) 2008, 2010, 2020 Malcolm Tyrrell.
+ * All rights reserved. This program and the accompanying materials
+ * are made available under the terms of the GNU Public License v3.0
+ * which accompanies this distribution, and is available at
+ * http://gplv3.fsf.org/
+ * ***************************************************************************/
+
+#ifndef TRACER_H_
+#define TRACER_H_
+
+#include <pthread.h>
+#include <string>
+#include <vector>
+
+/*!
+ * Records spans of activity on each thread and writes them out in the Chrome
+ * trace event format, which chrome://tracing and Perfetto can display.
+ * Tracing is off until start is called, and then costs little more than a test
+ * of a flag. Each thread records events into a buffer of its own, so recording
+ * takes no lock. The buffers are written out by stop.
+ * Names and categories must be string literals (or otherwise outlive the tracer).
+ */
+class Tracer
+{
+public:
+	/*!
+	 * Start tracing. This should be done before the threads to be traced are started.
+	 * \param filename the file the trace is written to by stop.
+	 * \return false if the file could not be opened.
+	 */
+	static bool start(const std::string& filename);
+	/*!
+	 * Stop tracing and write the trace. This should be done once the traced threads
+	 * have stopped recording events.
+	 */
+	static void stop();
+	/*!
+	 * Is tracing on.
+	 */
+	static bool isOn() { return s_on; }
+	/*!
+	 * Give the calling thread a name in the trace.
+	 */
+	static void nameThread(const char* name);
+	/*!
+	 * Record the value of a counter.
+	 */
+	static void counter(const char* name, long value);
+	/*!
+	 * Records a span of activity from its construction to its destruction.
+	 */
+	class Span
+	{
+	public:
+		/*!
+		 * Begin the span, if tracing is on.
+		 */
+		Span(const char* category, const char* name);
+		/*!
+		 * End the span, if it was begun.
+		 */
+		~Span();
+	private:
+		const char* m_category;
+		const char* m_name;
+		bool m_begun;
+	};
+private:
+	/*!
+	 * An event in the trace.
+	 */
+	struct Event {
+		const char* m_category;
+		const char* m_name;
+		/*!
+		 * The Chrome trace event phase: 'B' (begin), 'E' (end) or 'C' (counter).
+		 */
+		char m_phase;
+		/*!
+		 * Microseconds since tracing started.
+		 */
+		double m_time;
+		/*!
+		 * The value of a counter.
+		 */
+		long m_value;
+	};
+	/*!
+	 * The events recorded by one thread.
+	 */
+	struct ThreadBuffer {
+		int m_threadId;
+		const char* m_threadName;
+		std::vector<Event> m_events;
+	};
+	/*!
+	 * Record an event on the calling thread.
+	 */
+	static void record(char phase, const char* category, const char* name, long value);
+	/*!
+	 * Get the calling thread's buffer, creating it if necessary.
+	 */
+	static ThreadBuffer* getBuffer();
+	/*!
+	 * Microseconds since tracing started.
+	 */
+	static double getTime();
+	/*!
+	 * Is tracing on.
+	 */
+	static bool s_on;
+	/*!
+	 * The file the trace is written to.
+	 */
+	static std::string s_filename;
+	/*!
+	 * The time tracing started, in microseconds.
+	 */
+	static double s_startTime;
+	/*!
+	 * The buffers of all the threads which have recorded events. They are kept
+	 * after the threads exit, until the trace is written.
+	 */
+	static std::vector<ThreadBuffer*> s_buffers;
+	/*!
+	 * Serializes the creation of buffers.
+	 */
+	static pthread_mutex_t s_lock;
+	/*!
+	 * The calling thread's buffer.
+	 */
+	static __thread ThreadBuffer* t_buffer;
+};
+
+inline Tracer::Span::Span(const char* category, const char* name)
+: m_category(category)
+, m_name(name)
+, m_begun(s_on)
+{
+	if (m_begun)
+		record('B', m_category, m_name, 0);
+}
+
+inline Tracer::Span::~Span()
+{
+	if (m_begun)
+		record('E', m_category, m_name, 0);
+}
+
+#endif /*TRACER_H_*/
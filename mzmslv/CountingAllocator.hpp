@@ -0,0 +1,81 @@
+/* ***************************************************************************
+ * CountingAllocator.hpp
+ * Copyright (c) 2008, 2010, 2020 Malcolm Tyrrell.
+ * All rights reserved. This program and the accompanying materials
+ * are made available under the terms of the GNU Public License v3.0
+ * which accompanies this distribution, and is available at
+ * http://gplv3.fsf.org/
+ * ***************************************************************************/
+
+#ifndef COUNTINGALLOCATOR_H_
+#define COUNTINGALLOCATOR_H_
+
+#include <cstddef>
+#include <new>
+
+#include "MemoryAccount.hpp"
+
+namespace mzmslv {
+
+/*!
+ * An allocator for standard containers which accounts for the memory it allocates
+ * in the calling thread's MemoryAccount as being of kind K.
+ */
+template<class T, SolverStats::Kind K>
+class CountingAllocator
+{
+public:
+	typedef T value_type;
+	typedef T* pointer;
+	typedef const T* const_pointer;
+	typedef T& reference;
+	typedef const T& const_reference;
+	typedef std::size_t size_type;
+	typedef std::ptrdiff_t difference_type;
+
+	template<class U>
+	struct rebind {
+		typedef CountingAllocator<U, K> other;
+	};
+
+	CountingAllocator() { }
+	template<class U>
+	CountingAllocator(const CountingAllocator<U, K>&) { }
+
+	pointer allocate(size_type n, const void* = 0) {
+		pointer p = static_cast<pointer>(::operator new(n * sizeof(T)));
+		MemoryAccount::allocated(K, n * sizeof(T));
+		return p;
+	}
+	void deallocate(pointer p, size_type n) {
+		MemoryAccount::freed(K, n * sizeof(T));
+		::operator delete(p);
+	}
+	size_type max_size() const {
+		return static_cast<size_type>(-1) / sizeof(T);
+	}
+	void construct(pointer p, const T& value) {
+		new(static_cast<void*>(p)) T(value);
+	}
+	void destroy(pointer p) {
+		p->~T();
+	}
+	pointer address(reference r) const { return &r; }
+	const_pointer address(const_reference r) const { return &r; }
+};
+
+template<class T, class U, SolverStats::Kind K>
+inline bool operator== (const CountingAllocator<T, K>&, const CountingAllocator<U, K>&)
+{
+	return true;
+}
+
+template<class T, class U, SolverStats::Kind K>
+inline bool operator!= (const CountingAllocator<T, K>&, const CountingAllocator<U, K>&)
+{
+	return false;
+}
+
+} // namespace mzmslv
+
+#endif /*COUNTINGALLOCATOR_H_*/
@@ -0,0 +1,112 @@
+/* ***************************************************************************
+ * LockFreeQueue.hpp
+ * Copyright (c) 2008, 2010, 2020 Malcolm Tyrrell.
+ * All rights reserved. This program and the accompanying materials
+ * are made available under the terms of the GNU Public License v3.0
+ * which accompanies this distribution, and is available at
+ * http://gplv3.fsf.org/
+ * ***************************************************************************/
+
+#ifndef LOCKFREEQUEUE_H_
+#define LOCKFREEQUEUE_H_
+
+namespace mzmslv {
+
+/*!
+ * An unbounded queue which one thread can push onto while another pops from it,
+ * without either of them taking a lock.
+ * At most one thread may push at a time, and at most one thread may pop at a time.
+ * Pushes from different threads must be serialized by the caller (e.g. by a mutex).
+ */
+template<class T>
+class LockFreeQueue
+{
+public:
+	/*!
+	 * Constructor.
+	 */
+	LockFreeQueue();
+	/*!
+	 * Destructor. Any values still in the queue are discarded.
+	 */
+	~LockFreeQueue();
+	/*!
+	 * Add a value to the back of the queue. Never blocks.
+	 */
+	void push(const T& value);
+	/*!
+	 * Remove the value at the front of the queue.
+	 * \return false if the queue was empty.
+	 */
+	bool pop(T& value);
+private:
+	/*!
+	 * The queue is a linked list of nodes.
+	 */
+	struct Node {
+		T m_value;
+		Node* m_next;
+	};
+	/*!
+	 * A node whose successor is the front of the queue. Only accessed by the popping thread.
+	 */
+	Node* m_head;
+	/*!
+	 * The node at the back of the queue. Only accessed by the pushing thread.
+	 */
+	Node* m_tail;
+	/*!
+	 * Not copyable.
+	 */
+	LockFreeQueue(const LockFreeQueue&);
+	LockFreeQueue& operator=(const LockFreeQueue&);
+};
+
+//
+// Template implementation.
+//
+
+template<class T>
+LockFreeQueue<T>::LockFreeQueue()
+{
+	m_head = m_tail = new Node;
+	m_head->m_next = 0;
+}
+
+template<class T>
+LockFreeQueue<T>::~LockFreeQueue()
+{
+	while (m_head) {
+		Node* next = m_head->m_next;
+		delete m_head;
+		m_head = next;
+	}
+}
+
+template<class T>
+void LockFreeQueue<T>::push(const T& value)
+{
+	Node* node = new Node;
+	node->m_value = value;
+	node->m_next = 0;
+	// The release makes the value visible to the popping thread along with the node.
+	__atomic_store_n(&m_tail->m_next, node, __ATOMIC_RELEASE);
+	m_tail = node;
+}
+
+template<class T>
+bool LockFreeQueue<T>::pop(T& value)
+{
+	Node* next = __atomic_load_n(&m_head->m_next, __ATOMIC_ACQUIRE);
+	if (!next)
+		return false;
+	value = next->m_value;
+	// The old head is no longer reachable by the pushing thread, which is at or beyond next.
+	delete m_head;
+	m_head = next;
+	return true;
+}
+
+} // namespace mzmslv
+
+#endif /*LOCKFREEQUEUE_H_*/
@@ -0,0 +1,43 @@
+/* ***************************************************************************
+ * MemoryAccount.cpp
+ * Copyright (c) 2008, 2010, 2020 Malcolm Tyrrell.
+ * All rights reserved. This program and the accompanying materials
+ * are made available under the terms of the GNU Public License v3.0
+ * which accompanies this distribution, and is available at
+ * http://gplv3.fsf.org/
+ * ***************************************************************************/
+
+#include "MemoryAccount.hpp"
+
+#include <new>
+
+namespace mzmslv {
+
+__thread MemoryAccount* MemoryAccount::t_current = 0;
+
+MemoryAccount::MemoryAccount(SolverStats& stats)
+: m_stats(stats)
+, m_previous(t_current)
+{
+	t_current = this;
+}
+
+MemoryAccount::~MemoryAccount()
+{
+	t_current = m_previous;
+}
+
+void* MemoryAccount::allocate(SolverStats::Kind kind, std::size_t bytes)
+{
+	void* memory = ::operator new(bytes);
+	allocated(kind, bytes);
+	return memory;
+}
+
+void MemoryAccount::deallocate(SolverStats::Kind kind, void* memory, std::size_t bytes)
+{
+	freed(kind, bytes);
+	::operator delete(memory);
+}
+
+} // namespace mzmslv
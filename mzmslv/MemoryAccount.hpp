@@ -0,0 +1,88 @@
+/* ***************************************************************************
+ * MemoryAccount.hpp
+ * Copyright (c) 2008, 2010, 2020 Malcolm Tyrrell.
+ * All rights reserved. This program and the accompanying materials
+ * are made available under the terms of the GNU Public License v3.0
+ * which accompanies this distribution, and is available at
+ * http://gplv3.fsf.org/
+ * ***************************************************************************/
+
+#ifndef MEMORYACCOUNT_H_
+#define MEMORYACCOUNT_H_
+
+#include <cstddef>
+
+#include "SolverStats.hpp"
+
+namespace mzmslv {
+
+/*!
+ * While one of these exists, the memory allocated and freed by the thread which
+ * created it is accounted for in a SolverStats. Allocations and frees on a thread
+ * with no account are ignored, so only the memory used while a job runs is counted.
+ * Accounts nest: the previous account of the thread is restored on destruction.
+ */
+class MemoryAccount
+{
+public:
+	/*!
+	 * Start accounting for the calling thread's memory in the stats.
+	 */
+	MemoryAccount(SolverStats& stats);
+	/*!
+	 * Stop accounting.
+	 */
+	~MemoryAccount();
+	/*!
+	 * Account for memory allocated by the calling thread.
+	 */
+	static inline void allocated(SolverStats::Kind kind, unsigned long bytes);
+	/*!
+	 * Account for memory freed by the calling thread.
+	 */
+	static inline void freed(SolverStats::Kind kind, unsigned long bytes);
+	/*!
+	 * Allocate memory and account for it, for use by a class's operator new.
+	 * The memory must be given back by deallocate.
+	 */
+	static void* allocate(SolverStats::Kind kind, std::size_t bytes);
+	/*!
+	 * Give back memory from allocate and account for it, for use by a class's
+	 * operator delete.
+	 */
+	static void deallocate(SolverStats::Kind kind, void* memory, std::size_t bytes);
+private:
+	/*!
+	 * The stats being accounted into.
+	 */
+	SolverStats& m_stats;
+	/*!
+	 * The account of the calling thread which was replaced by this.
+	 */
+	MemoryAccount* m_previous;
+	/*!
+	 * The account of the calling thread, or NULL.
+	 */
+	static __thread MemoryAccount* t_current;
+	/*!
+	 * Not copyable.
+	 */
+	MemoryAccount(const MemoryAccount&);
+	MemoryAccount& operator=(const MemoryAccount&);
+};
+
+inline void MemoryAccount::allocated(SolverStats::Kind kind, unsigned long bytes)
+{
+	if (t_current)
+		t_current->m_stats.allocated(kind, bytes);
+}
+
+inline void MemoryAccount::freed(SolverStats::Kind kind, unsigned long bytes)
+{
+	if (t_current)
+		t_current->m_stats.freed(kind, bytes);
+}
+
+} // namespace mzmslv
+
+#endif /*MEMORYACCOUNT_H_*/
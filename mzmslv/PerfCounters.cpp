@@ -0,0 +1,124 @@
+/* ***************************************************************************
+ * PerfCounters.cpp
+ * Copyright (c) 2008, 2010, 2020 Malcolm Tyrrell.
+ * All rights reserved. This program and the accompanying materials
+ * are made available under the terms of the GNU Public License v3.0
+ * which accompanies this distribution, and is available at
+ * http://gplv3.fsf.org/
+ * ***************************************************************************/
+
+#include "PerfCounters.hpp"
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <string.h>
+#include <unistd.h>
+
+namespace mzmslv {
+
+bool PerfCounters::s_enabled = false;
+__thread PerfCounters* PerfCounters::t_current = 0;
+
+void PerfCounters::setEnabled(bool enabled)
+{
+	s_enabled = enabled;
+}
+
+bool PerfCounters::isEnabled()
+{
+	return s_enabled;
+}
+
+bool PerfCounters::isAvailable()
+{
+	const bool enabled = s_enabled;
+	s_enabled = true;
+	SolverStats stats;
+	{
+		PerfCounters counters(stats);
+	}
+	s_enabled = enabled;
+	return stats.m_counted;
+}
+
+/*!
+ * Open a counter of a hardware event for the calling thread.
+ * \param groupFd the group leader, or -1 to open a leader.
+ * \return the file descriptor, or -1 on failure.
+ */
+static int openCounter(unsigned long long config, int groupFd)
+{
+	perf_event_attr attr;
+	memset(&attr, 0, sizeof(attr));
+	attr.size = sizeof(attr);
+	attr.type = PERF_TYPE_HARDWARE;
+	attr.config = config;
+	attr.disabled = (groupFd == -1) ? 1 : 0;
+	attr.exclude_kernel = 1;
+	attr.exclude_hv = 1;
+	attr.read_format = PERF_FORMAT_GROUP;
+	return syscall(__NR_perf_event_open, &attr, 0, -1, groupFd, 0);
+}
+
+PerfCounters::PerfCounters(SolverStats& stats)
+: m_stats(stats)
+, m_previous(t_current)
+{
+	for (int e = 0; e < SolverStats::NUM_EVENTS; ++e)
+		m_fd[e] = -1;
+	if (!s_enabled)
+		return;
+
+	static const unsigned long long configs[SolverStats::NUM_EVENTS] = {
+		PERF_COUNT_HW_CPU_CYCLES,
+		PERF_COUNT_HW_INSTRUCTIONS,
+		PERF_COUNT_HW_CACHE_MISSES,
+		PERF_COUNT_HW_BRANCH_MISSES
+	};
+	for (int e = 0; e < SolverStats::NUM_EVENTS; ++e) {
+		m_fd[e] = openCounter(configs[e], m_fd[0]);
+		if (m_fd[e] == -1) {
+			for (int f = 0; f < e; ++f) {
+				close(m_fd[f]);
+				m_fd[f] = -1;
+			}
+			return;
+		}
+	}
+	ioctl(m_fd[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+	m_stats.m_counted = true;
+	t_current = this;
+}
+
+PerfCounters::~PerfCounters()
+{
+	if (m_fd[0] == -1)
+		return;
+	t_current = m_previous;
+	for (int e = 0; e < SolverStats::NUM_EVENTS; ++e)
+		close(m_fd[e]);
+}
+
+bool PerfCounters::read(unsigned long long* values) const
+{
+	// With PERF_FORMAT_GROUP, the counters are read together as the number of
+	// counters followed by their values.
+	unsigned long long buffer[1 + SolverStats::NUM_EVENTS];
+	if (::read(m_fd[0], buffer, sizeof(buffer)) != sizeof(buffer))
+		return false;
+	for (int e = 0; e < SolverStats::NUM_EVENTS; ++e)
+		values[e] = buffer[1 + e];
+	return true;
+}
+
+void PerfCounters::count(SolverStats::Phase phase, const unsigned long long* start)
+{
+	unsigned long long end[SolverStats::NUM_EVENTS];
+	if (!read(end))
+		return;
+	for (int e = 0; e < SolverStats::NUM_EVENTS; ++e)
+		m_stats.m_counts[phase][e] += end[e] - start[e];
+}
+
+} // namespace mzmslv
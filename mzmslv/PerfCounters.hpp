@@ -0,0 +1,119 @@
+/* ***************************************************************************
+ * PerfCounters.hpp
+ * Copyright (c) 2008, 2010, 2020 Malcolm Tyrrell.
+ * All rights reserved. This program and the accompanying materials
+ * are made available under the terms of the GNU Public License v3.0
+ * which accompanies this distribution, and is available at
+ * http://gplv3.fsf.org/
+ * ***************************************************************************/
+
+#ifndef PERFCOUNTERS_H_
+#define PERFCOUNTERS_H_
+
+#include "SolverStats.hpp"
+
+namespace mzmslv {
+
+/*!
+ * A group of hardware performance counters (from perf_event_open) for the thread
+ * which creates it, which count events in the scopes of the search into a SolverStats.
+ * Counting is off unless enabled. If the counters can't be opened (e.g. because
+ * the kernel doesn't allow it), nothing is counted and the stats are marked as such.
+ * Each scope reads the counters twice, which costs two system calls, so
+ * counting slows the search down noticeably.
+ */
+class PerfCounters
+{
+public:
+	/*!
+	 * Enable or disable counting for counters created from now on.
+	 */
+	static void setEnabled(bool enabled);
+	/*!
+	 * Is counting enabled.
+	 */
+	static bool isEnabled();
+	/*!
+	 * Can counters be opened on the calling thread.
+	 */
+	static bool isAvailable();
+	/*!
+	 * Open the counters for the calling thread if counting is enabled, and count
+	 * the events of scopes on this thread into the stats until destruction.
+	 */
+	PerfCounters(SolverStats& stats);
+	/*!
+	 * Close the counters.
+	 */
+	~PerfCounters();
+	/*!
+	 * Counts the events which occur between its construction and its destruction
+	 * as belonging to a phase, if the calling thread has counters.
+	 */
+	class Scope
+	{
+	public:
+		inline Scope(SolverStats::Phase phase);
+		inline ~Scope();
+	private:
+		/*!
+		 * The counters of the thread, or NULL.
+		 */
+		PerfCounters* m_counters;
+		SolverStats::Phase m_phase;
+		unsigned long long m_start[SolverStats::NUM_EVENTS];
+	};
+private:
+	/*!
+	 * Read the counters.
+	 * \return false if they could not be read.
+	 */
+	bool read(unsigned long long* values) const;
+	/*!
+	 * Add the counts since start to the phase.
+	 */
+	void count(SolverStats::Phase phase, const unsigned long long* start);
+	/*!
+	 * The file descriptors of the counters. The first is the group leader.
+	 */
+	int m_fd[SolverStats::NUM_EVENTS];
+	/*!
+	 * The stats being counted into.
+	 */
+	SolverStats& m_stats;
+	/*!
+	 * The counters of the calling thread which were replaced by these.
+	 */
+	PerfCounters* m_previous;
+	/*!
+	 * Is counting enabled.
+	 */
+	static bool s_enabled;
+	/*!
+	 * The counters of the calling thread, or NULL.
+	 */
+	static __thread PerfCounters* t_current;
+	/*!
+	 * Not copyable.
+	 */
+	PerfCounters(const PerfCounters&);
+	PerfCounters& operator=(const PerfCounters&);
+};
+
+inline PerfCounters::Scope::Scope(SolverStats::Phase phase)
+: m_counters(t_current)
+, m_phase(phase)
+{
+	if (m_counters && !m_counters->read(m_start))
+		m_counters = 0;
+}
+
+inline PerfCounters::Scope::~Scope()
+{
+	if (m_counters)
+		m_counters->count(m_phase, m_start);
+}
+
+} // namespace mzmslv
+
+#endif /*PERFCOUNTERS_H_*/
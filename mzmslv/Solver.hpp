@@ -12,16 +12,30 @@
 
 #include<vector>
 #include<queue>
+#include<deque>
 #include<algorithm>
 #include<map>
 #include<stack>
 #include<set>
 #include<cassert>
 
+#include <mzmcommon/Tracer/Tracer.hpp>
+
+#include "CountingAllocator.hpp"
+#include "PerfCounters.hpp"
 #include "SolverTypes.hpp"
 
 namespace mzmslv {
 
+/*!
+ * The state of a search is kept in one of these when the search is suspended.
+ */
+class SearchState
+{
+public:
+	virtual ~SearchState() { }
+};
+
 /*!
  * The solver class.
  * \param C a configuration.
@@ -38,12 +52,13 @@ public:
 	/*!
 	 * Constructor.
 	 */	
-	Solver() : m_keepSolving(true) { }
+	Solver() : m_keepSolving(true), m_suspending(false), m_searchState(0) { }
 	
 	/*!
 	 * Destructor.
+	 * Discards the state of a suspended search, if there is one.
 	 */
-	virtual ~Solver() { }
+	virtual ~Solver() { discardSearch(); }
 
 	/*!
 	 * Use a solver of the appropriate type to solve the problem.
@@ -85,6 +100,17 @@ public:
 	 */
 	SolverResult findSolutionAStar(C* init, path& p);
 	
+	/*!
+	 * Finds a cheapest solution if there is one using a uniform-cost (Dijkstra)
+	 * search, where getCost() of a configuration gives the cost of the step
+	 * which reached it, which must be at least one. Of the cheapest solutions,
+	 * it finds one whose steps have the least total getTieCost().
+	 * For consistency of memory management, init will be put on p regardless.
+	 * \param init the initial configuration.
+	 * \param p the path to add the solution to.
+	 */
+	SolverResult findSolutionUniformCost(C* init, path& p);
+	
 	/*!
 	 * Checks if there is a solution using a breadth-first search.
 	 * \param init the initial configuration.
@@ -112,11 +138,26 @@ public:
 	/*!
 	 * Set m_keepSolving to true;
 	 */
-	void go() { m_keepSolving = true; }
+	void go() { m_keepSolving = true; m_suspending = false; }
 	/*!
 	 * Set m_keepSolving to false;
 	 */
 	void stop() { m_keepSolving = false; }
+	/*!
+	 * Interrupt the solver, but keep the state of the search so that the next call
+	 * to findSolution (after go) continues from where it left off. 
+	 * The interrupted call returns SUSPENDED.
+	 */
+	void suspend() { m_suspending = true; m_keepSolving = false; }
+	/*!
+	 * Is there a suspended search waiting to be resumed?
+	 */
+	bool isSuspended() const { return m_searchState != 0; }
+	/*!
+	 * Throw away the state of a suspended search, if there is one.
+	 * This must be called while the initial configuration still exists.
+	 */
+	void discardSearch() { delete m_searchState; m_searchState = 0; }
 private:
 	/*!
 	 * Finds a solution if there is one, putting nodes into config_queue with push and choosing
@@ -140,10 +181,23 @@ private:
 	template<SolverResult (Solver::* solve) (C*, path&)>
 	SolverResult isSolvable_g(C* init);
 	
+	/*!
+	 * When tracing, the size of the search is recorded after this many configurations are expanded.
+	 */
+	static const unsigned int TRACE_INTERVAL = 4096;
+	
 	/*!
 	 * A flag which threads can use to interrupt the solver.
 	 */
 	bool m_keepSolving;
+	/*!
+	 * Set if the interruption is a suspension rather than a stop.
+	 */
+	bool m_suspending;
+	/*!
+	 * The state of a suspended search, or NULL.
+	 */
+	SearchState* m_searchState;
 };
 
 /* ***************************************************************************
@@ -190,6 +244,8 @@ SolverResult Solver<C>::findSolution(SearchType type, C* init, typename Solver<C
 			return findSolutionBestFirst(init,p);
 		case(A_STAR):
 			return findSolutionAStar(init,p);
+		case(UNIFORM_COST):
+			return findSolutionUniformCost(init,p);
 	}
 	assert(false);
 }
@@ -198,26 +254,71 @@ SolverResult Solver<C>::findSolution(SearchType type, C* init, typename Solver<C
  * findSolution_g
  * **************************************************************************/
 
+/*!
+ * The state of a suspended findSolution_g search.
+ */
+template<class C, class config_queue>
+class QueueSearchState : public SearchState
+{
+public:
+	typedef std::map<C*, C*, CompareConfigurationPointers<C>, CountingAllocator<std::pair<C* const, C*>, SolverStats::KIND_VISITED> > configuration_set;
+	/*!
+	 * Start a search from init.
+	 */
+	QueueSearchState(C* i) : init(i) {
+		// We've encountered the initial Configuration.
+		encountered[init] = 0;
+		// the first path is the path containing just the initial Configuration.
+		current_configs.push(init);
+	}
+	/*!
+	 * Deletes all configurations still contained in the encountered set, except init.
+	 */
+	virtual ~QueueSearchState() {
+		encountered.erase(init);
+		for (typename configuration_set::iterator i = encountered.begin(); i != encountered.end(); ++i)
+			delete (*i).first;
+	}
+	/*!
+	 * The initial configuration.
+	 */
+	C* init;
+	/*!
+	 * the "set" of nodes we've encountered so far stores parent pointers.
+	 */
+	configuration_set encountered;
+	/*!
+	 * the paths we're considering.
+	 */
+	config_queue current_configs;
+};
+
 template<class C> template<class config_queue, const typename config_queue::value_type& (config_queue::* next) () const>
 SolverResult Solver<C>::findSolution_g(C* init, Solver<C>::path& p)
 {
-	// Push the initial configuration onto the path regardless.
-	p.push_back(init);
+	typedef QueueSearchState<C, config_queue> search_state;
+	typedef typename search_state::configuration_set configuration_set;
+	
+	Tracer::Span span("search", "search");
+	
+	// Continue a suspended search, or start a new one.
+	search_state* state = static_cast<search_state*>(m_searchState);
+	m_searchState = 0;
+	if (!state) {
+		// Push the initial configuration onto the path regardless.
+		p.push_back(init);
+		state = new search_state(init);
+	}
+	assert(state->init == init);
 	
 	// the value we will return.
 	SolverResult ret = NO_SOLUTION;
 	
-	// the "set" of nodes we've encountered so far stores parent pointers. 
-	typedef std::map<C*, C*, CompareConfigurationPointers<C> > configuration_set;
 	// the Configurations we've encountered so far.
-	configuration_set encountered;
-	// We've encountered the initial Configuration.
-	encountered[init] = 0;
+	configuration_set& encountered = state->encountered;
 	
 	// the paths we're considering.
-	config_queue current_configs;
-	// the first path is the path containing just the initial Configuration.
-	current_configs.push(init);
+	config_queue& current_configs = state->current_configs;
 	
 	// a vector for putting neighbours in.
 	std::vector<C*> neighbours;
@@ -225,14 +326,20 @@ SolverResult Solver<C>::findSolution_g(C* init, Solver<C>::path& p)
 	// a pointer to the path at the front of the queue.
 	C* top_config;	
 	
+	// used to trace the progress of the search now and then.
+	unsigned int numExpanded = 0;
+	
 	// keep iterating until we've found a solution or we've tried all paths.
 	while (m_keepSolving && !current_configs.empty()) {
+		if (((++numExpanded % TRACE_INTERVAL) == 0) && Tracer::isOn())
+			Tracer::counter("encountered", encountered.size());
 		top_config = (current_configs.*next)();
 		// we're now considering the top_path, so we can remove it from current_paths.
 		current_configs.pop();
 		
 		// we've found a winning path.
 		if (top_config->isGoal()) {	
+			Tracer::Span traceBack("search", "trace back");
 			// trace back through parent pointers to obtain the winning path.
 			path reverse_path;
 			for (C* c = top_config; c != init; c = encountered[c]) 
@@ -249,7 +356,11 @@ SolverResult Solver<C>::findSolution_g(C* init, Solver<C>::path& p)
 		}
 		
 		// iterate over its the neighbours.
-		top_config->getNeighbours(neighbours);
+		{
+			PerfCounters::Scope scope(SolverStats::PHASE_NEIGHBOURS);
+			top_config->getNeighbours(neighbours);
+		}
+		PerfCounters::Scope duplicatesScope(SolverStats::PHASE_DUPLICATES);
 		for(typename std::vector<C*>::iterator i = neighbours.begin(); i != neighbours.end(); ++i) {
 			// only use neighbours not yet encountered.	
 			if (encountered.find(*i) == encountered.end()) {
@@ -263,14 +374,18 @@ SolverResult Solver<C>::findSolution_g(C* init, Solver<C>::path& p)
 		neighbours.clear();
 	}
 
-	if (!m_keepSolving)
-		ret = INTERRUPTED;
+	if (!m_keepSolving) {
+		if (m_suspending && (ret != FOUND_SOLUTION)) {
+			// Keep the search for later.
+			m_searchState = state;
+			return SUSPENDED;
+		}
+		if (!m_suspending)
+			ret = INTERRUPTED;
+	}
 	
-	// Ensure we don't erase init.
-	encountered.erase(init);
 	// delete all Configurations still contained in the encountered set.
-	for (typename configuration_set::iterator i = encountered.begin(); i != encountered.end(); ++i)
-		delete (*i).first;
+	delete state;
 	
 	return ret;
 }
@@ -300,7 +415,8 @@ SolverResult Solver<C>::findSolutionBreadthFirst(C* init, typename Solver<C>::pa
 	// use a queue to obtain a standard breadth-first search.
 	// Newly expanded nodes are pushed at the back.
 	// The front is the oldest node (i.e. the one with a shortest path so far).
-	return findSolution_g<std::queue<C*> , &std::queue<C*>::front>(init, p);
+	typedef std::queue<C*, std::deque<C*, CountingAllocator<C*, SolverStats::KIND_QUEUE> > > config_queue;
+	return findSolution_g<config_queue , &config_queue::front>(init, p);
 }
 
 template<class C>
@@ -309,7 +425,7 @@ SolverResult Solver<C>::findSolutionBestFirst(C* init, typename Solver<C>::path&
 	// use a priority_queue to obtain a greedy search.
 	// Newly expanded nodes are pushed at the back.
 	// The front is the node with the highest priority (i.e. the lowest getEstimatedDistance()).
-	typedef std::priority_queue<C*, std::vector<C*>, CompareByDistance<C> > config_queue;
+	typedef std::priority_queue<C*, std::vector<C*, CountingAllocator<C*, SolverStats::KIND_QUEUE> >, CompareByDistance<C> > config_queue;
 	return findSolution_g<config_queue , &config_queue::top>(init, p);
 }
 
@@ -317,7 +433,8 @@ SolverResult Solver<C>::findSolutionBestFirst(C* init, typename Solver<C>::path&
 template<class C>
 SolverResult Solver<C>::findSolutionDepthFirst(C* init, typename Solver<C>::path& p) 
 {
-	return findSolution_g<std::stack<C*> , &std::stack<C*>::top>(init, p);
+	typedef std::stack<C*, std::deque<C*, CountingAllocator<C*, SolverStats::KIND_QUEUE> > > config_queue;
+	return findSolution_g<config_queue , &config_queue::top>(init, p);
 }
 
 /* **************************************************************************
@@ -386,6 +503,19 @@ public:
 	 * it can be quite slow.
 	 */
 	Node (C* cc, float gg, C* p) : config(cc), g(gg), h(cc->getEstimatedDistance()), parent(p) { }
+	
+	/*!
+	 * Nodes are accounted for as queue storage.
+	 */
+	static void* operator new(std::size_t size) {
+		void* node = ::operator new(size);
+		MemoryAccount::allocated(SolverStats::KIND_QUEUE, size);
+		return node;
+	}
+	static void operator delete(void* node, std::size_t size) {
+		MemoryAccount::freed(SolverStats::KIND_QUEUE, size);
+		::operator delete(node);
+	}
 };
 
 /*!
@@ -401,38 +531,96 @@ public:
 	};	
 };
 
+/*!
+ * The state of a suspended A* search.
+ */
+template<class C>
+class AStarSearchState : public SearchState
+{
+public:
+	typedef std::map<C*,C*,CompareConfigurationPointers<C>,CountingAllocator<std::pair<C* const,C*>,SolverStats::KIND_VISITED> > configuration_set;
+	typedef std::vector<Node<C>*,CountingAllocator<Node<C>*,SolverStats::KIND_QUEUE> > node_heap;
+	typedef std::map<C*,Node<C>*,CompareConfigurationPointers<C>,CountingAllocator<std::pair<C* const,Node<C>*>,SolverStats::KIND_QUEUE> > node_map;
+	/*!
+	 * Start a search from init.
+	 */
+	AStarSearchState(C* i) : init(i) {
+		// the initial node.
+		Node<C>* init_n = new Node<C>(init,0.0,0);
+		open_heap.push_back(init_n);
+		open_map[init] = init_n;
+	}
+	/*!
+	 * Deletes the remaining nodes and configurations, except init.
+	 */
+	virtual ~AStarSearchState() {
+		// Erase the remaining configurations in the closed set.
+		closed_set.erase(init);
+		for (typename configuration_set::iterator i = closed_set.begin(); i != closed_set.end(); ++i)
+			delete (*i).first;
+		// Erase the remaining nodes and configurations open set.
+		for (typename node_heap::iterator i = open_heap.begin(); i != open_heap.end(); ++i) {
+			if ((*i)->config != init)
+				delete (*i)->config;
+			delete *i;
+		}
+	}
+	/*!
+	 * The initial configuration.
+	 */
+	C* init;
+	/*!
+	 * the set of nodes we have already explored.
+	 */
+	configuration_set closed_set;
+	/*!
+	 * The open set is the set of nodes we know about but haven't explored yet.
+	 * We manage this in two redundant ways:
+	 * We will maintain it as a heap with respect to f values.
+	 */
+	node_heap open_heap;
+	/*!
+	 * And also as a configuration -> node mapping.
+	 */
+	node_map open_map;
+};
+
 template<class C>
 SolverResult Solver<C>::findSolutionAStar(C* init, typename Solver<C>::path& p) 
 {
-	typedef std::map<C*,C*,CompareConfigurationPointers<C> > configuration_set;
-	typedef std::vector<Node<C>*> node_heap;
-	typedef std::map<C*,Node<C>*,CompareConfigurationPointers<C> > node_map;
+	typedef AStarSearchState<C> search_state;
+	typedef typename search_state::configuration_set configuration_set;
+	typedef typename search_state::node_heap node_heap;
+	typedef typename search_state::node_map node_map;
 	CompareNodePointersByF<C> cmp;
 	
-	// the value we will return.
-	SolverResult ret = NO_SOLUTION;
+	Tracer::Span span("search", "A* search");
 	
-	// the set of nodes we have already explored.
-	configuration_set closed_set;
+	// Continue a suspended search, or start a new one.
+	search_state* state = static_cast<search_state*>(m_searchState);
+	m_searchState = 0;
+	if (!state)
+		state = new search_state(init);
+	assert(state->init == init);
 	
-	// The open set is the set of nodes we know about but haven't explored yet.
-	// We manage this in two redundant ways:
-	// We will maintain it as a heap with respect to f values.
-	node_heap open_heap;
-	// And also as a configuration -> node mapping.
-	node_map open_map;
+	// the value we will return.
+	SolverResult ret = NO_SOLUTION;
 	
-	// the initial node.
-	Node<C>* init_n = new Node<C>(init,0.0,0);
-	open_heap.push_back(init_n);
-	open_map[init] = init_n;
+	configuration_set& closed_set = state->closed_set;
+	node_heap& open_heap = state->open_heap;
+	node_map& open_map = state->open_map;
 	
 	// used to point to the node with least f.
 	Node<C>* top_node;
 	// used for the set of neighbours.
 	std::vector<C*> neighbours;
 	
+	// used to trace the progress of the search now and then.
+	unsigned int numExpanded = 0;
+	
 	while (!open_heap.empty() && m_keepSolving) {
+		if (((++numExpanded % TRACE_INTERVAL) == 0) && Tracer::isOn())
+			Tracer::counter("encountered", closed_set.size() + open_map.size());
 		// the front of the open_set is the one with the lowest f.
 		top_node = open_heap.front();
 		// we've expanded top_node, so we can move it from the open_set to the closed_set.
@@ -443,6 +631,7 @@ SolverResult Solver<C>::findSolutionAStar(C* init, typename Solver<C>::path& p)
 		
 		// have we found the winning node?
 		if (top_node->config->isGoal()) {
+			Tracer::Span traceBack("search", "trace back");
 			// trace back through parent pointers to obtain the winning path.
 			path reverse_path;
 			for (C* c = top_node->config; c != 0; c = closed_set[c]) 
@@ -460,7 +649,11 @@ SolverResult Solver<C>::findSolutionAStar(C* init, typename Solver<C>::path& p)
 		}
 		
 		// get the neighbouring configurations and iterate over them.
-		top_node->config->getNeighbours(neighbours);
+		{
+			PerfCounters::Scope scope(SolverStats::PHASE_NEIGHBOURS);
+			top_node->config->getNeighbours(neighbours);
+		}
+		PerfCounters::Scope duplicatesScope(SolverStats::PHASE_DUPLICATES);
 		for (typename std::vector<C*>::iterator n = neighbours.begin(); n != neighbours.end(); ++n) {
 			// Only consider nodes not already in the closed set.
 			if (closed_set.find(*n) == closed_set.end()) {
@@ -492,27 +685,299 @@ SolverResult Solver<C>::findSolutionAStar(C* init, typename Solver<C>::path& p)
 		neighbours.clear();	
 	} 
 	
+	if (!m_keepSolving && m_suspending && (ret != FOUND_SOLUTION)) {
+		// Keep the search for later.
+		m_searchState = state;
+		return SUSPENDED;
+	}
+	
 	// if we haven't found a solution.
-	if (ret != FOUND_SOLUTION) {
+	if (ret != FOUND_SOLUTION)
 		p.push_back(init);
-		// ensure we don't delete init.
-		closed_set.erase(init);
-	}
 	
-	if (!m_keepSolving)
+	if (!m_keepSolving && !m_suspending)
 		ret = INTERRUPTED;
 	
-	// Erase the remaining configurations in the closed set.
-	for (typename configuration_set::iterator i = closed_set.begin(); i != closed_set.end(); ++i) {
-		delete (*i).first;
+	// Erase the remaining nodes and configurations.
+	delete state;
+	
+	return ret;
+}
+
+/* **************************************************************************
+ * Uniform-cost code
+ * **************************************************************************/
+
+/*!
+ * The state of a suspended uniform-cost search.
+ * The costs of steps are small whole numbers, so the queue is a bucket for
+ * each cost. The configurations encountered are kept in a hash table using
+ * their getHash, as there are usually many more of them than in the other
+ * searches, and each is looked up several times.
+ * Configurations of the same cost are ordered by their tie cost, which is
+ * only improved by the steps of cheaper configurations, so it is the least
+ * there is by the time their bucket is reached.
+ */
+template<class C>
+class UniformCostSearchState : public SearchState
+{
+public:
+	/*!
+	 * What is known of an encountered configuration.
+	 */
+	struct Entry {
+		/*!
+		 * The configuration, or NULL once it has been put on the path.
+		 */
+		C* config;
+		/*!
+		 * The low bits of the hash of the configuration.
+		 */
+		unsigned int hash;
+		/*!
+		 * The entry of the configuration from which it is most cheaply reached, or NO_ENTRY for init.
+		 */
+		unsigned int parent;
+		/*!
+		 * The least cost of reaching it found so far.
+		 */
+		unsigned int cost : 31;
+		/*!
+		 * Has it been expanded, which means the cost is the least there is?
+		 */
+		unsigned int isExpanded : 1;
+		/*!
+		 * The least tie cost of reaching it at that cost.
+		 */
+		unsigned int tieCost;
+	};
+	typedef std::vector<Entry, CountingAllocator<Entry, SolverStats::KIND_VISITED> > entry_vector;
+	typedef std::vector<unsigned int, CountingAllocator<unsigned int, SolverStats::KIND_VISITED> > entry_table;
+	typedef std::vector<unsigned int, CountingAllocator<unsigned int, SolverStats::KIND_QUEUE> > bucket;
+	/*!
+	 * Marks an empty slot of the table, and the parent of init.
+	 */
+	static const unsigned int NO_ENTRY = ~0U;
+	/*!
+	 * Start a search from init.
+	 */
+	UniformCostSearchState(C* i) : init(i), table(1024, NO_ENTRY), currentCost(0), nextInBucket(0) {
+		const unsigned long long hash = init->getHash();
+		add(find(init, hash), init, hash, NO_ENTRY, 0, 0);
+	}
+	/*!
+	 * Deletes all configurations still contained in the encountered set, except init.
+	 */
+	virtual ~UniformCostSearchState() {
+		for (typename entry_vector::iterator i = entries.begin(); i != entries.end(); ++i)
+			if ((*i).config != init)
+				delete (*i).config;
+	}
+	/*!
+	 * Find the slot of the table which holds the entry of a configuration, or
+	 * the empty slot where it belongs.
+	 */
+	unsigned int find(const C* config, unsigned long long hash) const {
+		const unsigned int mask = table.size() - 1;
+		unsigned int slot = hash & mask;
+		for (; table[slot] != NO_ENTRY; slot = (slot + 1) & mask) {
+			const Entry& entry = entries[table[slot]];
+			if ((entry.hash == (unsigned int) hash) && !(*entry.config < *config) && !(*config < *entry.config))
+				break;
+		}
+		return slot;
+	}
+	/*!
+	 * Add an entry for a configuration in the empty slot of the table where it belongs,
+	 * and put it in the queue.
+	 */
+	void add(unsigned int slot, C* config, unsigned long long hash, unsigned int parent, unsigned int cost, unsigned int tieCost) {
+		Entry entry = { config, (unsigned int) hash, parent, cost, false, tieCost };
+		table[slot] = entries.size();
+		entries.push_back(entry);
+		queue(entries.size() - 1, cost);
+		// Keep the table at most half full.
+		if (entries.size() * 2 > table.size())
+			grow();
+	}
+	/*!
+	 * Put an entry in the queue.
+	 */
+	void queue(unsigned int e, unsigned int cost) {
+		assert(cost >= currentCost);
+		if (cost >= buckets.size())
+			buckets.resize(cost + 1);
+		buckets[cost].push_back(e);
+	}
+	/*!
+	 * Double the size of the table.
+	 */
+	void grow() {
+		entry_table bigger(table.size() * 2, NO_ENTRY);
+		const unsigned int mask = bigger.size() - 1;
+		for (unsigned int e = 0; e < entries.size(); ++e) {
+			unsigned int slot = entries[e].hash & mask;
+			while (bigger[slot] != NO_ENTRY)
+				slot = (slot + 1) & mask;
+			bigger[slot] = e;
+		}
+		table.swap(bigger);
+	}
+	/*!
+	 * The initial configuration.
+	 */
+	C* init;
+	/*!
+	 * The configurations we've encountered so far, in the order they were found.
+	 */
+	entry_vector entries;
+	/*!
+	 * The hash table of the numbers of the entries, which is open addressed, and
+	 * whose size is a power of two at least twice the number of entries.
+	 */
+	entry_table table;
+	/*!
+	 * The entries waiting to be expanded, by the cost of reaching them. An
+	 * entry is queued again when a cheaper way of reaching it is found, and
+	 * is skipped in the bucket of the dearer cost.
+	 */
+	std::deque<bucket> buckets;
+	/*!
+	 * The cost of the bucket being expanded. The buckets of lower costs are empty.
+	 */
+	unsigned int currentCost;
+	/*!
+	 * The position in that bucket of the next entry to expand.
+	 */
+	unsigned int nextInBucket;
+};
+
+template<class C>
+const unsigned int UniformCostSearchState<C>::NO_ENTRY;
+
+template<class C>
+SolverResult Solver<C>::findSolutionUniformCost(C* init, typename Solver<C>::path& p)
+{
+	typedef UniformCostSearchState<C> search_state;
+	typedef typename search_state::Entry Entry;
+	typedef typename search_state::bucket bucket;
+	
+	Tracer::Span span("search", "uniform-cost search");
+	
+	// Continue a suspended search, or start a new one.
+	search_state* state = static_cast<search_state*>(m_searchState);
+	m_searchState = 0;
+	if (!state) {
+		// Push the initial configuration onto the path regardless.
+		p.push_back(init);
+		state = new search_state(init);
 	}
+	assert(state->init == init);
+	
+	// the value we will return.
+	SolverResult ret = NO_SOLUTION;
+	
+	// a vector for putting neighbours in.
+	std::vector<C*> neighbours;
 	
-	// Erase the remaining nodes and configurations open set.
-	for (typename node_heap::iterator i = open_heap.begin(); i != open_heap.end(); ++i) {
-		delete (*i)->config;
-		delete *i;
+	// used to trace the progress of the search now and then.
+	unsigned int numExpanded = 0;
+	
+	while (m_keepSolving && (state->currentCost < state->buckets.size())) {
+		bucket& current = state->buckets[state->currentCost];
+		if (state->nextInBucket == current.size()) {
+			// Move on to the next cost, freeing the bucket.
+			bucket().swap(current);
+			++state->currentCost;
+			state->nextInBucket = 0;
+			continue;
+		}
+		const unsigned int top = current[state->nextInBucket++];
+		// skip the entries of configurations which were reached more cheaply since.
+		if (state->entries[top].isExpanded || (state->entries[top].cost != state->currentCost))
+			continue;
+		state->entries[top].isExpanded = true;
+		if (((++numExpanded % TRACE_INTERVAL) == 0) && Tracer::isOn())
+			Tracer::counter("encountered", state->entries.size());
+		C* top_config = state->entries[top].config;
+		
+		// we've found a cheapest winning path.
+		if (top_config->isGoal()) {
+			Tracer::Span traceBack("search", "trace back");
+			// the goals of this cost were all reached from cheaper configurations,
+			// so they are in the bucket already. Take the one with the least tie cost.
+			unsigned int goal = top;
+			for (unsigned int k = state->nextInBucket; k < current.size(); ++k) {
+				const Entry& other = state->entries[current[k]];
+				if ((other.cost == state->currentCost) && (other.tieCost < state->entries[goal].tieCost) && other.config->isGoal())
+					goal = current[k];
+			}
+			// trace back through parent indices to obtain the winning path.
+			path reverse_path;
+			for (unsigned int e = goal; e != 0; e = state->entries[e].parent) {
+				reverse_path.push_back(state->entries[e].config);
+				// ensure we don't delete these configs.
+				state->entries[e].config = 0;
+			}
+			
+			// Add the winning path to the provided path
+			for (typename std::vector<C*>::reverse_iterator i = reverse_path.rbegin(); i != reverse_path.rend(); ++i)
+				p.push_back(*i);
+			ret = FOUND_SOLUTION;
+			break;
+		}
+		
+		// iterate over its the neighbours.
+		{
+			PerfCounters::Scope scope(SolverStats::PHASE_NEIGHBOURS);
+			top_config->getNeighbours(neighbours);
+		}
+		PerfCounters::Scope duplicatesScope(SolverStats::PHASE_DUPLICATES);
+		for (typename std::vector<C*>::iterator i = neighbours.begin(); i != neighbours.end(); ++i) {
+			assert((*i)->getCost() > 0);
+			const unsigned int cost = state->currentCost + (*i)->getCost();
+			const unsigned int tieCost = state->entries[top].tieCost + (*i)->getTieCost();
+			const unsigned long long hash = (*i)->getHash();
+			const unsigned int slot = state->find(*i, hash);
+			if (state->table[slot] == search_state::NO_ENTRY) {
+				state->add(slot, *i, hash, top, cost, tieCost);
+			} else {
+				// If we can improve the old entry, do. The new configuration replaces
+				// the old one, as the step which reached it is now the one on the path.
+				const unsigned int old = state->table[slot];
+				Entry& entry = state->entries[old];
+				if (!entry.isExpanded && (cost < entry.cost)) {
+					entry.cost = cost;
+					entry.tieCost = tieCost;
+					entry.parent = top;
+					std::swap(entry.config, *i);
+					state->queue(old, cost);
+				} else if (!entry.isExpanded && (cost == entry.cost) && (tieCost < entry.tieCost)) {
+					// It's queued at this cost already.
+					entry.tieCost = tieCost;
+					entry.parent = top;
+					std::swap(entry.config, *i);
+				}
+				delete *i;
+			}
+		}
+		
+		neighbours.clear();
+	}
+
+	if (!m_keepSolving) {
+		if (m_suspending && (ret != FOUND_SOLUTION)) {
+			// Keep the search for later.
+			m_searchState = state;
+			return SUSPENDED;
+		}
+		if (!m_suspending)
+			ret = INTERRUPTED;
 	}
 	
+	// delete all Configurations still contained in the encountered set.
+	delete state;
+	
 	return ret;
 }
 
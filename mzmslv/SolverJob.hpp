@@ -12,14 +12,19 @@
 
 #include "WorkerPoolJob.hpp"
 #include "Solver.hpp"
+#include "MemoryAccount.hpp"
+#include "PerfCounters.hpp"
 
 namespace mzmslv {
 
 /*!
  * A workerPoolJob for solving problems with configurations of type C.
+ * The job derives from B, which must be a WorkerPoolJob: users can provide a
+ * subclass of WorkerPoolJob declaring getResult and getStats to handle jobs for
+ * different types of configuration alike.
  */
-template<class C>
-class SolverJob : public WorkerPoolJob
+template<class C, class B = WorkerPoolJob>
+class SolverJob : public B
 {
 public:
 	/*!
@@ -30,11 +35,14 @@ public:
 	SolverJob(SearchType searchType, C* init);
 	
 	// WorkerPoolJob interface.
-	virtual Outcome doJob();
+	virtual WorkerPoolJob::Outcome doJob();
 	virtual void stop();
+	virtual bool isSuspendable() const;
+	virtual void suspend();
+	virtual void resume();
 	
 	/*!
-	 * Deletes the solution path, but not the initial configuration.
+	 * Deletes the solution path, which includes the initial configuration.
 	 */
 	virtual ~SolverJob();
 	
@@ -47,6 +55,10 @@ public:
 	 * Gets the solution path.
 	 */
 	inline const typename Solver<C>::path& getPath() const;
+	/*!
+	 * Gets the memory use of the search and its hardware event counts, if counting was enabled.
+	 */
+	inline const SolverStats& getStats() const;
 protected:
 	/*!
 	 * The solver object which does the solving. 
@@ -79,50 +91,94 @@ protected:
 	 * The solution path.
 	 */
 	typename Solver<C>::path m_solutionPath;
+
+	/*!
+	 * The statistics of the search, accumulated over each time it was run.
+	 */
+	SolverStats m_stats;
 };
 
 // 
 // Template implementation.
 //
 
-template<class C>
-SolverJob<C>::SolverJob(SearchType searchType, C* init)
+template<class C, class B>
+SolverJob<C, B>::SolverJob(SearchType searchType, C* init)
 : m_searchType(searchType)
 , m_initConfig(init)
 {
 }
 
-template<class C>
-WorkerPoolJob::Outcome SolverJob<C>::doJob()
+template<class C, class B>
+WorkerPoolJob::Outcome SolverJob<C, B>::doJob()
 {
+	// The account and counters belong to the thread, so they're set up each time the job is run.
+	MemoryAccount account(m_stats);
+	PerfCounters counters(m_stats);
 	m_solverResult = m_solver.findSolution(m_searchType, m_initConfig, m_solutionPath);
-	return (m_solverResult != INTERRUPTED) ? JOB_FINISHED : JOB_INTERRUPTED;
+	switch (m_solverResult) {
+		case INTERRUPTED:
+			return WorkerPoolJob::JOB_INTERRUPTED;
+		case SUSPENDED:
+			return WorkerPoolJob::JOB_SUSPENDED;
+		default:
+			return WorkerPoolJob::JOB_FINISHED;
+	}
 }
 
-template<class C>
-void SolverJob<C>::stop()
+template<class C, class B>
+void SolverJob<C, B>::stop()
 {
 	m_solver.stop();
 }
 
-template<class C>
-SolverJob<C>::~SolverJob()
+template<class C, class B>
+bool SolverJob<C, B>::isSuspendable() const
 {
+	return true;
+}
+
+template<class C, class B>
+void SolverJob<C, B>::suspend()
+{
+	m_solver.suspend();
+}
+
+template<class C, class B>
+void SolverJob<C, B>::resume()
+{
+	m_solver.go();
+}
+
+template<class C, class B>
+SolverJob<C, B>::~SolverJob()
+{
+	// The suspended search refers to the initial configuration.
+	m_solver.discardSearch();
+	// The initial configuration is only on the path if the job was started.
+	if (m_solutionPath.empty())
+		delete m_initConfig;
 	Solver<C>::deletePath(m_solutionPath);
 }
 
-template<class C>
-SolverResult SolverJob<C>::getResult() const
+template<class C, class B>
+SolverResult SolverJob<C, B>::getResult() const
 {
 	return m_solverResult;
 }
 
-template<class C>
-const typename Solver<C>::path& SolverJob<C>::getPath() const
+template<class C, class B>
+const typename Solver<C>::path& SolverJob<C, B>::getPath() const
 {
 	return m_solutionPath;
 }
 
+template<class C, class B>
+const SolverStats& SolverJob<C, B>::getStats() const
+{
+	return m_stats;
+}
+
 } // namespace mzmslv
 
 #endif /*SOLVERJOB_H_*/
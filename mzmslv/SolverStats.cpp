@@ -0,0 +1,111 @@
+/* ***************************************************************************
+ * SolverStats.cpp
+ * Copyright (c) 2008, 2010, 2020 Malcolm Tyrrell.
+ * All rights reserved. This program and the accompanying materials
+ * are made available under the terms of the GNU Public License v3.0
+ * which accompanies this distribution, and is available at
+ * http://gplv3.fsf.org/
+ * ***************************************************************************/
+
+#include "SolverStats.hpp"
+
+namespace mzmslv {
+
+SolverStats::SolverStats()
+: m_counted(false)
+, m_liveTotalBytes(0)
+, m_peakTotalBytes(0)
+{
+	for (int p = 0; p < NUM_PHASES; ++p)
+		for (int e = 0; e < NUM_EVENTS; ++e)
+			m_counts[p][e] = 0;
+	for (int k = 0; k < NUM_KINDS; ++k) {
+		m_liveBytes[k] = 0;
+		m_peakBytes[k] = 0;
+	}
+}
+
+void SolverStats::add(const SolverStats& other)
+{
+	for (int k = 0; k < NUM_KINDS; ++k) {
+		m_liveBytes[k] += other.m_liveBytes[k];
+		if (other.m_peakBytes[k] > m_peakBytes[k])
+			m_peakBytes[k] = other.m_peakBytes[k];
+	}
+	m_liveTotalBytes += other.m_liveTotalBytes;
+	if (other.m_peakTotalBytes > m_peakTotalBytes)
+		m_peakTotalBytes = other.m_peakTotalBytes;
+
+	if (!other.m_counted)
+		return;
+	m_counted = true;
+	for (int p = 0; p < NUM_PHASES; ++p)
+		for (int e = 0; e < NUM_EVENTS; ++e)
+			m_counts[p][e] += other.m_counts[p][e];
+}
+
+const char* SolverStats::getPhaseName(Phase phase)
+{
+	switch (phase) {
+		case PHASE_NEIGHBOURS:
+			return "neighbours";
+		case PHASE_DUPLICATES:
+			return "duplicates";
+		case PHASE_ZONES:
+			return "zones";
+		default:
+			return "?";
+	}
+}
+
+const char* SolverStats::getKindName(Kind kind)
+{
+	switch (kind) {
+		case KIND_CONFIGURATIONS:
+			return "configurations";
+		case KIND_ARRAYS:
+			return "arrays";
+		case KIND_VISITED:
+			return "visited";
+		case KIND_QUEUE:
+			return "queue";
+		case KIND_ZONES:
+			return "zones";
+		default:
+			return "?";
+	}
+}
+
+const char* SolverStats::getEventName(Event event)
+{
+	switch (event) {
+		case EVENT_CYCLES:
+			return "cycles";
+		case EVENT_INSTRUCTIONS:
+			return "instructions";
+		case EVENT_CACHE_MISSES:
+			return "cache misses";
+		case EVENT_BRANCH_MISSES:
+			return "branch misses";
+		default:
+			return "?";
+	}
+}
+
+std::ostream& operator<< (std::ostream& os, const SolverStats& stats)
+{
+	os << "peak " << stats.m_peakTotalBytes << " bytes (";
+	for (int k = 0; k < SolverStats::NUM_KINDS; ++k)
+		os << (k ? ", " : "") << stats.m_peakBytes[k] << " " << SolverStats::getKindName(static_cast<SolverStats::Kind>(k));
+	os << "), live " << stats.m_liveTotalBytes << " bytes";
+	if (!stats.m_counted)
+		return os;
+	for (int p = 0; p < SolverStats::NUM_PHASES; ++p) {
+		os << "; " << SolverStats::getPhaseName(static_cast<SolverStats::Phase>(p)) << ":";
+		for (int e = 0; e < SolverStats::NUM_EVENTS; ++e)
+			os << (e ? ", " : " ") << stats.m_counts[p][e] << " " << SolverStats::getEventName(static_cast<SolverStats::Event>(e));
+	}
+	return os;
+}
+
+} // namespace mzmslv
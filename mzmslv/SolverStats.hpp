@@ -0,0 +1,156 @@
+/* ***************************************************************************
+ * SolverStats.hpp
+ * Copyright (c) 2008, 2010, 2020 Malcolm Tyrrell.
+ * All rights reserved. This program and the accompanying materials
+ * are made available under the terms of the GNU Public License v3.0
+ * which accompanies this distribution, and is available at
+ * http://gplv3.fsf.org/
+ * ***************************************************************************/
+
+#ifndef SOLVERSTATS_H_
+#define SOLVERSTATS_H_
+
+#include <ostream>
+
+namespace mzmslv {
+
+/*!
+ * Statistics collected while a search was done: the memory used by the search,
+ * broken down by what it was used for, and (if enabled) hardware event counts,
+ * broken down by the phase of the search they occurred in.
+ */
+class SolverStats
+{
+public:
+	/*!
+	 * The phases of a search which are counted.
+	 */
+	enum Phase {
+		/*!
+		 * Generating the neighbours of a configuration (which includes building zones).
+		 */
+		PHASE_NEIGHBOURS,
+		/*!
+		 * Checking whether neighbours have been encountered before.
+		 */
+		PHASE_DUPLICATES,
+		/*!
+		 * Building the zones of configurations which have them.
+		 */
+		PHASE_ZONES,
+		NUM_PHASES
+	};
+	/*!
+	 * The hardware events which are counted.
+	 */
+	enum Event {
+		EVENT_CYCLES,
+		EVENT_INSTRUCTIONS,
+		EVENT_CACHE_MISSES,
+		EVENT_BRANCH_MISSES,
+		NUM_EVENTS
+	};
+	/*!
+	 * The kinds of memory which are accounted for.
+	 */
+	enum Kind {
+		/*!
+		 * The configuration objects.
+		 */
+		KIND_CONFIGURATIONS,
+		/*!
+		 * The insets of configurations.
+		 */
+		KIND_ARRAYS,
+		/*!
+		 * The nodes of the sets of configurations already encountered.
+		 */
+		KIND_VISITED,
+		/*!
+		 * The storage of the queues of configurations to be expanded.
+		 */
+		KIND_QUEUE,
+		/*!
+		 * The zones shared between configurations.
+		 */
+		KIND_ZONES,
+		NUM_KINDS
+	};
+	/*!
+	 * Constructor.
+	 */
+	SolverStats();
+	/*!
+	 * Add the counts and live bytes of other to these, and take the larger of the peaks.
+	 */
+	void add(const SolverStats& other);
+	/*!
+	 * Account for memory allocated.
+	 */
+	inline void allocated(Kind kind, unsigned long bytes);
+	/*!
+	 * Account for memory freed.
+	 */
+	inline void freed(Kind kind, unsigned long bytes);
+	/*!
+	 * Get a name for the kind of memory.
+	 */
+	static const char* getKindName(Kind kind);
+	/*!
+	 * Get a name for the phase.
+	 */
+	static const char* getPhaseName(Phase phase);
+	/*!
+	 * Get a name for the event.
+	 */
+	static const char* getEventName(Event event);
+	/*!
+	 * Set if the events could be counted.
+	 */
+	bool m_counted;
+	/*!
+	 * The number of events of each type in each phase.
+	 */
+	unsigned long long m_counts[NUM_PHASES][NUM_EVENTS];
+	/*!
+	 * The number of bytes of each kind currently allocated.
+	 */
+	long m_liveBytes[NUM_KINDS];
+	/*!
+	 * The largest number of bytes of each kind allocated at any time.
+	 */
+	long m_peakBytes[NUM_KINDS];
+	/*!
+	 * The number of bytes of all kinds currently allocated.
+	 */
+	long m_liveTotalBytes;
+	/*!
+	 * The largest number of bytes of all kinds allocated at any time.
+	 */
+	long m_peakTotalBytes;
+};
+
+inline void SolverStats::allocated(Kind kind, unsigned long bytes)
+{
+	m_liveBytes[kind] += bytes;
+	if (m_liveBytes[kind] > m_peakBytes[kind])
+		m_peakBytes[kind] = m_liveBytes[kind];
+	m_liveTotalBytes += bytes;
+	if (m_liveTotalBytes > m_peakTotalBytes)
+		m_peakTotalBytes = m_liveTotalBytes;
+}
+
+inline void SolverStats::freed(Kind kind, unsigned long bytes)
+{
+	m_liveBytes[kind] -= bytes;
+	m_liveTotalBytes -= bytes;
+}
+
+/*!
+ * Write the statistics to an ostream on one line.
+ */
+std::ostream& operator<< (std::ostream& os, const SolverStats& stats);
+
+} // namespace mzmslv
+
+#endif /*SOLVERSTATS_H_*/
@@ -19,7 +19,8 @@ enum SearchType {
 	BREADTH_FIRST,
 	DEPTH_FIRST,
 	BEST_FIRST,
-	A_STAR
+	A_STAR,
+	UNIFORM_COST
 };
 
 /*!
@@ -37,7 +38,11 @@ enum SolverResult {
 	/*!
 	 * The solvers return this if they were interrupted.
 	 */
-	INTERRUPTED
+	INTERRUPTED,
+	/*!
+	 * The solvers return this if they were suspended and can be resumed.
+	 */
+	SUSPENDED
 };
 
 } // namespace mzmslv
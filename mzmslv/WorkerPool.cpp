@@ -9,47 +9,59 @@
 
 #include "WorkerPool.hpp"
 
+#include <mzmcommon/Tracer/Tracer.hpp>
+
 #include <cassert>
+#include <cstdlib>
+#include <algorithm>
+#include <time.h>
+#include <unistd.h>
 
 namespace mzmslv {
 
 WorkerPool::WorkerPool(int numThreads)
-: m_numPoolMembers(numThreads)
-, m_numMembersWorking(0)
+: m_automaticNumThreads(numThreads == AUTOMATIC_NUM_THREADS)
+, m_pinned(false)
+, m_numJobsRunning(0)
+, m_generation(0)
 , m_state(WAITING_FOR_CLIENT)
 , m_client(NULL)
+, m_nextClientJob(NULL)
+, m_clientHasNoMoreJobs(false)
 {
-	// Allocate memory for the threads.
-	m_poolMembers = new WorkerPoolMember[numThreads];
-	
-	// Initialize the mutex and the barriers.
+	// Initialize the mutex and the condition variables.
 	pthread_mutex_init(&m_clientLock,NULL);
-	pthread_barrier_init(&m_startBarrier, NULL, m_numPoolMembers + 1);
-	pthread_barrier_init(&m_endBarrier, NULL, m_numPoolMembers + 1);
+	pthread_cond_init(&m_workAvailable, NULL);
+	pthread_cond_init(&m_workDone, NULL);
 	
-	// initialize the solver threads.
-	for (int i = 0; i < numThreads; ++i) {
-		m_poolMembers[i].m_pool = this;
-		m_poolMembers[i].m_job = NULL;
-		pthread_create(&m_poolMembers[i].m_thread, NULL, threadStartPoint, static_cast<void*>(&m_poolMembers[i]));
+	if (sched_getaffinity(0, sizeof(m_processors), &m_processors) != 0) {
+		CPU_ZERO(&m_processors);
+		CPU_SET(0, &m_processors);
 	}
+	
+	// initialize the solver threads.
+	pthread_mutex_lock(&m_clientLock);
+	resize(m_automaticNumThreads ? getAutomaticNumThreads() : numThreads);
+	pthread_mutex_unlock(&m_clientLock);
 }
 
 
 WorkerPool::~WorkerPool()
 {
 	releaseAsynchronous();
-	m_state = STOPPING;
 	
-	// Wait for the threads to resynchronize.
- 	pthread_barrier_wait(&m_startBarrier);
+	// Wake the threads and tell them to finish.
+	pthread_mutex_lock(&m_clientLock);
+	m_state = STOPPING;
+	resize(0);
+	pthread_mutex_unlock(&m_clientLock);
  	
 	// Wait for the solver threads to finish.
-	for (int i = 0; i < m_numPoolMembers; ++i) {
-		pthread_join(m_poolMembers[i].m_thread, NULL);
-	}
+	joinRetiredMembers(true);
 	
-	delete[] m_poolMembers;
+	pthread_cond_destroy(&m_workDone);
+	pthread_cond_destroy(&m_workAvailable);
+	pthread_mutex_destroy(&m_clientLock);
 }
 
 
@@ -57,120 +69,428 @@ void* WorkerPool::threadStartPoint(void* arg)
 {
 	WorkerPoolMember* a = static_cast<WorkerPoolMember*>(arg);
 	WorkerPool *const pool = a->m_pool;
-	// Wait until there's a new set of problems or the object is being destroyed.
-	pthread_barrier_wait(&pool->m_startBarrier);
+	Tracer::nameThread("pool thread");
+	pool->lockClient(a);
 	// Keep working until we're told to stop.
-	while (pool->m_state != STOPPING) {
+	while (!a->m_retiring) {
 		// While there are problems, solve them.
-		if (!pool->doAJob(a))
-		{
-			// Synchronize when the work is finished.
-			pthread_barrier_wait(&pool->m_endBarrier);
-			// Wait for a new set of problems (or destruction).
-			pthread_barrier_wait(&pool->m_startBarrier);
-		}	
+		if (!pool->doAJob(a)) {
+			// Wait for a new set of problems (or retirement).
+			const double start = getTime();
+			pthread_cond_wait(&pool->m_workAvailable, &pool->m_clientLock);
+			a->m_stats.m_idleTime += getTime() - start;
+		}
 	}
+	a->m_exited = true;
+	pthread_mutex_unlock(&pool->m_clientLock);
 	return 0;
 }
 
+int WorkerPool::getNumProcessors()
+{
+	const long numProcessors = sysconf(_SC_NPROCESSORS_ONLN);
+	return (numProcessors > 0) ? numProcessors : 1;
+}
+
+int WorkerPool::getAutomaticNumThreads() const
+{
+	int numThreads = getNumProcessors() - 1;
+	// The load average includes our own jobs.
+	double load;
+	if (getloadavg(&load, 1) == 1) {
+		const int otherLoad = static_cast<int>(load + 0.5) - m_numJobsRunning;
+		if (otherLoad > 0)
+			numThreads -= otherLoad;
+	}
+	return std::max(numThreads, 1);
+}
+
+void WorkerPool::resize(int numThreads)
+{
+	if ((m_state == WORKING_ASYNCHRONOUSLY) && (numThreads < 1))
+		numThreads = 1;
+	// Retire the most recently created members first.
+	while (static_cast<int>(m_poolMembers.size()) > numThreads) {
+		WorkerPoolMember* member = m_poolMembers.back();
+		m_poolMembers.pop_back();
+		member->m_retiring = true;
+		// Let the remaining members carry on with its job.
+		if (member->m_job && !member->m_preempted && member->m_job->isSuspendable() && !m_poolMembers.empty()) {
+			member->m_preempted = true;
+			member->m_job->suspend();
+		}
+		m_retiredMembers.push_back(member);
+	}
+	// Wake idle retiring members.
+	pthread_cond_broadcast(&m_workAvailable);
+	while (static_cast<int>(m_poolMembers.size()) < numThreads) {
+		WorkerPoolMember* member = new WorkerPoolMember;
+		member->m_pool = this;
+		member->m_job = NULL;
+		member->m_preempted = false;
+		member->m_generation = m_generation;
+		member->m_retiring = false;
+		member->m_exited = false;
+		pthread_create(&member->m_thread, NULL, threadStartPoint, static_cast<void*>(member));
+		if (m_pinned)
+			pinMember(member, m_poolMembers.size());
+		m_poolMembers.push_back(member);
+	}
+}
+
+void WorkerPool::joinRetiredMembers(bool all)
+{
+	std::vector<WorkerPoolMember*> toJoin;
+	pthread_mutex_lock(&m_clientLock);
+	std::vector<WorkerPoolMember*>::iterator i = m_retiredMembers.begin(); 
+	while (i != m_retiredMembers.end()) {
+		if (all || (*i)->m_exited) {
+			toJoin.push_back(*i);
+			i = m_retiredMembers.erase(i);
+		} else
+			++i;
+	}
+	pthread_mutex_unlock(&m_clientLock);
+	if (toJoin.empty())
+		return;
+	for (i = toJoin.begin(); i != toJoin.end(); ++i)
+		pthread_join((*i)->m_thread, NULL);
+	// Keep the stats of the threads.
+	pthread_mutex_lock(&m_clientLock);
+	for (i = toJoin.begin(); i != toJoin.end(); ++i)
+		m_stats.m_poolThreads.push_back((*i)->m_stats);
+	pthread_mutex_unlock(&m_clientLock);
+	for (i = toJoin.begin(); i != toJoin.end(); ++i)
+		delete *i;
+}
+
+void WorkerPool::setNumThreads(int numThreads)
+{
+	pthread_mutex_lock(&m_clientLock);
+	m_automaticNumThreads = (numThreads == AUTOMATIC_NUM_THREADS);
+	resize(m_automaticNumThreads ? getAutomaticNumThreads() : numThreads);
+	pthread_mutex_unlock(&m_clientLock);
+	joinRetiredMembers(false);
+}
+
+bool WorkerPool::pinMember(WorkerPoolMember* member, int position)
+{
+	cpu_set_t processors;
+	if (m_pinned) {
+		// Find the processor after the first which is (position mod count) along.
+		const int numProcessors = CPU_COUNT(&m_processors);
+		int skip = (numProcessors > 1) ? (position % (numProcessors - 1)) + 1 : 0;
+		int processor = 0;
+		while (!CPU_ISSET(processor, &m_processors) || (skip-- > 0))
+			++processor;
+		CPU_ZERO(&processors);
+		CPU_SET(processor, &processors);
+	} else
+		processors = m_processors;
+	return pthread_setaffinity_np(member->m_thread, sizeof(processors), &processors) == 0;
+}
+
+bool WorkerPool::setPinned(bool pinned)
+{
+	pthread_mutex_lock(&m_clientLock);
+	m_pinned = pinned;
+	bool success = true;
+	for (unsigned int i = 0; i < m_poolMembers.size(); ++i)
+		success = pinMember(m_poolMembers[i], i) && success;
+	pthread_mutex_unlock(&m_clientLock);
+	return success;
+}
+
+int WorkerPool::getNumThreads() const
+{
+	pthread_mutex_lock(&m_clientLock);
+	const int numThreads = m_poolMembers.size();
+	pthread_mutex_unlock(&m_clientLock);
+	return numThreads;
+}
+
+bool WorkerPool::isWorking() const
+{
+	return (m_state == WORKING_SYNCHRONOUSLY) || (m_state == WORKING_ASYNCHRONOUSLY);
+}
+
+void WorkerPool::takeNextJob(WorkerPoolMember* worker)
+{
+	assert(!worker->m_job);
+	if (!m_nextClientJob && !m_clientHasNoMoreJobs) {
+		m_nextClientJob = m_client->getNextJob();
+		m_clientHasNoMoreJobs = (m_nextClientJob == NULL);
+	}
+	// Find the highest priority suspended job.
+	int suspendedPriority = WorkerPoolJob::NUM_PRIORITIES - 1;
+	while ((suspendedPriority >= 0) && m_suspendedJobs[suspendedPriority].empty())
+		--suspendedPriority;
+	// Suspended jobs go before new jobs of the same priority.
+	if (m_nextClientJob && (m_nextClientJob->getPriority() > suspendedPriority)) {
+		worker->m_job = m_nextClientJob;
+		m_nextClientJob = m_client->getNextJob();
+		m_clientHasNoMoreJobs = (m_nextClientJob == NULL);
+	} else if (suspendedPriority >= 0) {
+		worker->m_job = m_suspendedJobs[suspendedPriority].front();
+		m_suspendedJobs[suspendedPriority].pop_front();
+		worker->m_job->resume();
+	}
+	worker->m_preempted = false;
+	if (m_nextClientJob)
+		preemptFor(m_nextClientJob->getPriority());
+}
+
+void WorkerPool::preemptFor(WorkerPoolJob::Priority priority)
+{
+	WorkerPoolMember* lowest = NULL;
+	for (std::vector<WorkerPoolMember*>::iterator i = m_poolMembers.begin(); i != m_poolMembers.end(); ++i) {
+		WorkerPoolMember& member = **i;
+		// A member without a job, one which is already being preempted, or one
+		// doing a stale job will soon be free.
+		if (!member.m_job || member.m_preempted || (member.m_generation != m_generation))
+			return;
+		if (member.m_job->isSuspendable() && (!lowest || (member.m_job->getPriority() < lowest->m_job->getPriority())))
+			lowest = &member;
+	}
+	if (lowest && (lowest->m_job->getPriority() < priority)) {
+		lowest->m_preempted = true;
+		lowest->m_job->suspend();
+	}
+}
+
+void WorkerPool::discardWaitingJobs()
+{
+	delete m_nextClientJob;
+	m_nextClientJob = NULL;
+	for (int p = 0; p < WorkerPoolJob::NUM_PRIORITIES; ++p) {
+		for (std::deque<WorkerPoolJob*>::iterator i = m_suspendedJobs[p].begin(); i != m_suspendedJobs[p].end(); ++i)
+			delete *i;
+		m_suspendedJobs[p].clear();
+	}
+}
+
+bool WorkerPool::isClientFinished() const
+{
+	if ((m_numJobsRunning > 0) || m_nextClientJob || !m_clientHasNoMoreJobs)
+		return false;
+	for (int p = 0; p < WorkerPoolJob::NUM_PRIORITIES; ++p)
+		if (!m_suspendedJobs[p].empty())
+			return false;
+	return true;
+}
+
 bool WorkerPool::doAJob(WorkerPoolMember* worker)
 {
 	assert(!worker->m_job);
-	pthread_mutex_lock(&m_clientLock);
-	// Ask the client for a new job unless it has released the pool
-	if ( (m_state == WORKING_SYNCHRONOUSLY) || (m_state == WORKING_ASYNCHRONOUSLY) )
-		worker->m_job = m_client->getNextJob();
+	// Obtain a new job unless the client has released the pool
+	if (isWorking()) {
+		try {
+			takeNextJob(worker);
+		} catch (...) {
+			// The client couldn't give a job. Its jobs underway are abandoned, as
+			// they would be by releaseAsynchronous, so it won't hear from the pool again.
+			worker->m_job = NULL;
+			abandonClient();
+			throw;
+		}
+	}
+	if (worker->m_job == NULL) {
+		// Let anyone waiting know if that was the last of the client's jobs.
+		if (isWorking() && isClientFinished())
+			pthread_cond_broadcast(&m_workDone);
+		return false;
+	}
+	worker->m_generation = m_generation;
+	++m_numJobsRunning;
 	pthread_mutex_unlock(&m_clientLock);
-	// The return value. Assume that there will be no subsequent job to obtain.
-	bool getSubsequentJob = false;
-	// Did we get a new problem?
-	if (worker->m_job != NULL) {
-		if (worker->m_job->doJob() == WorkerPoolJob::JOB_FINISHED) {
-			pthread_mutex_lock(&m_clientLock);
-			// Inform the client unless the it has released the pool.
-			if ( (m_state == WORKING_SYNCHRONOUSLY) || (m_state == WORKING_ASYNCHRONOUSLY) )
-			{
-				m_client->jobDone(worker->m_job);
-				// Since this job was successful, we should try to get another one.
-				getSubsequentJob = true;
-			}
-			pthread_mutex_unlock(&m_clientLock);
+	
+	const double start = getTime();
+	WorkerPoolJob::Outcome outcome;
+	{
+		Tracer::Span span("job", worker->m_job->getTypeName());
+		outcome = worker->m_job->doJob();
+	}
+	const double time = getTime() - start;
+	
+	lockClient(worker);
+	WorkerPoolJob* job = worker->m_job;
+	++worker->m_stats.m_numJobs;
+	worker->m_stats.m_busyTime += time;
+	m_stats.m_jobTimes[job->getTypeName()].add(time);
+	// Nobody can ask the job to stop once it's been cleared.
+	worker->m_job = NULL;
+	// Inform the client unless the it has released the pool since the job was started.
+	if (worker->m_generation == m_generation) {
+		--m_numJobsRunning;
+		switch (outcome) {
+			case WorkerPoolJob::JOB_FINISHED:
+				// The job now belongs to the client.
+				m_client->jobDone(job);
+				job = NULL;
+				break;
+			case WorkerPoolJob::JOB_SUSPENDED:
+				m_suspendedJobs[job->getPriority()].push_back(job);
+				job = NULL;
+				// Make sure the suspended job isn't left behind.
+				pthread_cond_signal(&m_workAvailable);
+				break;
+			default:
+				assert(false);
 		}
-#ifndef NDEBUG
-		else
-			assert(m_state == WAITING_FOR_CLIENT);
-#endif
-		delete worker->m_job;
-		worker->m_job = NULL;
-	} else {
-		pthread_mutex_lock(&m_clientLock);
-		--m_numMembersWorking;
+		// The member may be retiring, and so not look for another job, so let
+		// anyone waiting know if that was the last of the client's jobs.
+		if (isClientFinished())
+			pthread_cond_broadcast(&m_workDone);
+	}
+	if (job) {
+		// Deleting a job can take a while, so do it without the lock.
 		pthread_mutex_unlock(&m_clientLock);
+		delete job;
+		lockClient(worker);
 	}
-	return getSubsequentJob;
+	return true;
 }
 
+void WorkerPool::startClient(WorkerPoolClient* client, State state)
+{
+	m_client = client;
+	m_clientHasNoMoreJobs = false;
+	m_state = state;
+	if (m_automaticNumThreads)
+		resize(getAutomaticNumThreads());
+	// Start the pool threads.
+	pthread_cond_broadcast(&m_workAvailable);
+}
 
 void WorkerPool::workSynchronous(WorkerPoolClient* client)
 {
 	releaseAsynchronous();
-	m_state = WORKING_SYNCHRONOUSLY;
-	m_client = client;
-	// Start the pool threads.
-	pthread_barrier_wait(&m_startBarrier);
+	pthread_mutex_lock(&m_clientLock);
+	startClient(client, WORKING_SYNCHRONOUSLY);
 	WorkerPoolMember worker;
 	worker.m_thread = NULL;
 	worker.m_job = NULL;
+	worker.m_preempted = false;
+	worker.m_retiring = false;
+	worker.m_exited = false;
 	worker.m_pool = this;
-	while (doAJob(&worker));
+	try {
+		while (doAJob(&worker));
+	} catch (...) {
+		// The client has been abandoned, so the pool is ready for the next.
+		pthread_mutex_unlock(&m_clientLock);
+		throw;
+	}
 	// Wait for the pool threads to finish.
-	pthread_barrier_wait(&m_endBarrier);
+	const double start = getTime();
+	while (!isClientFinished())
+		pthread_cond_wait(&m_workDone, &m_clientLock);
+	worker.m_stats.m_barrierWaitTime += getTime() - start;
+	m_stats.m_clientThread.add(worker.m_stats);
+	m_state = WAITING_FOR_CLIENT;
+	pthread_mutex_unlock(&m_clientLock);
 }
 
 
 void WorkerPool::workAsynchronous(WorkerPoolClient* client)
 {
-	if (m_numPoolMembers == 0)
+	if (getNumThreads() == 0)
 		throw NoPoolMembers();
 	releaseAsynchronous();
-	m_client = client;
-	m_state = WORKING_ASYNCHRONOUSLY;
-	m_numMembersWorking = m_numPoolMembers;
-	// Start the pool threads.
-	pthread_barrier_wait(&m_startBarrier);
+	pthread_mutex_lock(&m_clientLock);
+	startClient(client, WORKING_ASYNCHRONOUSLY);
+	pthread_mutex_unlock(&m_clientLock);
 }
 
 
 void WorkerPool::releaseAsynchronous()
 {
-	if (m_state == WORKING_ASYNCHRONOUSLY) {
-		// We lock the client to guarantee that it won't receive subsequent
-		// jobDone callbacks, and also to ensure that the call to stop is not
-		// called on a deleted object.
-		pthread_mutex_lock(&m_clientLock);
-		m_state = WAITING_FOR_CLIENT;
-		// Tell any working threads not to bother.
-		for (int i = 0; i < m_numPoolMembers; ++i)
-			if (m_poolMembers[i].m_job) 
-				m_poolMembers[i].m_job->stop();
-		pthread_mutex_unlock(&m_clientLock);
-		// Return the threads to the start state.
-		pthread_barrier_wait(&m_endBarrier);
-	}
+	// We lock the client to guarantee that it won't receive subsequent
+	// jobDone callbacks, and also to ensure that the call to stop is not
+	// called on a deleted object.
+	pthread_mutex_lock(&m_clientLock);
+	if (m_state == WORKING_ASYNCHRONOUSLY)
+		abandonClient();
+	pthread_mutex_unlock(&m_clientLock);
+	joinRetiredMembers(false);
+}
+
+void WorkerPool::abandonClient()
+{
+	m_state = WAITING_FOR_CLIENT;
+	// The jobs underway are now stale.
+	++m_generation;
+	m_numJobsRunning = 0;
+	// Tell any working threads not to bother.
+	for (std::vector<WorkerPoolMember*>::iterator i = m_poolMembers.begin(); i != m_poolMembers.end(); ++i)
+		if ((*i)->m_job) 
+			(*i)->m_job->stop();
+	for (std::vector<WorkerPoolMember*>::iterator i = m_retiredMembers.begin(); i != m_retiredMembers.end(); ++i)
+		if ((*i)->m_job) 
+			(*i)->m_job->stop();
+	discardWaitingJobs();
 }
 
 void WorkerPool::waitAsynchronous()
 {
+	pthread_mutex_lock(&m_clientLock);
 	if (m_state == WORKING_ASYNCHRONOUSLY) {
-		m_state = WAITING_FOR_CLIENT;
 		// Wait for the threads to finish.
-		pthread_barrier_wait(&m_endBarrier);
+		const double start = getTime();
+		while (!isClientFinished())
+			pthread_cond_wait(&m_workDone, &m_clientLock);
+		m_stats.m_clientThread.m_barrierWaitTime += getTime() - start;
+		m_state = WAITING_FOR_CLIENT;
 	}
+	pthread_mutex_unlock(&m_clientLock);
 }
 
 bool WorkerPool::isFinished() const
 {
-	return m_numMembersWorking == 0;
+	pthread_mutex_lock(&m_clientLock);
+	const bool finished = !isWorking() || isClientFinished();
+	pthread_mutex_unlock(&m_clientLock);
+	return finished;
+}
+
+void WorkerPool::lockClient(WorkerPoolMember* member)
+{
+	// Only time the wait if there is one.
+	if (pthread_mutex_trylock(&m_clientLock) != 0) {
+		const double start = getTime();
+		pthread_mutex_lock(&m_clientLock);
+		member->m_stats.m_lockWaitTime += getTime() - start;
+	}
+}
+
+double WorkerPool::getTime()
+{
+	timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+WorkerPoolStats WorkerPool::getStats() const
+{
+	pthread_mutex_lock(&m_clientLock);
+	WorkerPoolStats stats = m_stats;
+	for (std::vector<WorkerPoolMember*>::const_iterator i = m_retiredMembers.begin(); i != m_retiredMembers.end(); ++i)
+		stats.m_poolThreads.push_back((*i)->m_stats);
+	for (std::vector<WorkerPoolMember*>::const_iterator i = m_poolMembers.begin(); i != m_poolMembers.end(); ++i)
+		stats.m_poolThreads.push_back((*i)->m_stats);
+	pthread_mutex_unlock(&m_clientLock);
+	return stats;
+}
+
+void WorkerPool::resetStats()
+{
+	pthread_mutex_lock(&m_clientLock);
+	m_stats = WorkerPoolStats();
+	for (std::vector<WorkerPoolMember*>::iterator i = m_retiredMembers.begin(); i != m_retiredMembers.end(); ++i)
+		(*i)->m_stats = WorkerPoolStats::ThreadStats();
+	for (std::vector<WorkerPoolMember*>::iterator i = m_poolMembers.begin(); i != m_poolMembers.end(); ++i)
+		(*i)->m_stats = WorkerPoolStats::ThreadStats();
+	pthread_mutex_unlock(&m_clientLock);
 }
 
 } // namespace mzmslv
@@ -11,9 +11,13 @@
 #define WORKERPOOL_H_
 
 #include <pthread.h>
+#include <sched.h>
+#include <deque>
+#include <vector>
 
 #include "WorkerPoolClient.hpp"
 #include "WorkerPoolMember.hpp"
+#include "WorkerPoolStats.hpp"
 
 namespace mzmslv {
 
@@ -21,13 +25,23 @@ namespace mzmslv {
  * A pool of workers, which can do work simulateously.
  * The workerPool is not itself thread safe (i.e. the solverPool should not be used
  * by multiple client threads).
+ * Jobs are started in order of priority. The pool keeps the next job from the client
+ * in hand, and if it has a higher priority than a job being done by a pool thread
+ * when no pool thread is free, the lower priority job is suspended and requeued.
+ * The number of pool threads can be changed at any time.
  */
 class WorkerPool
 {
 public:
+	/*!
+	 * Pass this as a number of threads to let the pool choose the number itself, 
+	 * based on the number of processors and the current load. The pool then
+	 * reconsiders the number whenever it starts working for a client.
+	 */
+	static const int AUTOMATIC_NUM_THREADS = -1;
 	/*!
 	 * Constructor.
-	 * \param numThreads the number of solver threads to create.
+	 * \param numThreads the number of solver threads to create, or AUTOMATIC_NUM_THREADS.
 	 */
 	WorkerPool(int numThreads);
 	/*!
@@ -38,6 +52,8 @@ public:
 	 * Do work using the pool threads and the main thread, returning when all the problems
 	 * have been solved.
 	 * \param client the client which provides jobs and is informed when they are finished.
+	 * \throw anything the client's getNextJob throws on this thread, after the
+	 * jobs underway have been abandoned. It must not throw on the pool threads.
 	 */
 	void workSynchronous(WorkerPoolClient* client);
 	/*!
@@ -57,6 +73,9 @@ public:
 	 * in receiving solutions. Can be safely called even if the pool was not solving
 	 * asynchronously. The client will not receive jobDone callbacks after this method
 	 * has returned.
+	 * This does not wait for the jobs underway to notice that they have been stopped.
+	 * Their results are discarded when they return, and the threads are then free 
+	 * to work for the next client.
 	 */
 	void releaseAsynchronous();
 	/*!
@@ -67,28 +86,142 @@ public:
 	 * Has an asynchronous solver finished.
 	 */
 	bool isFinished() const;
+	/*!
+	 * Change the number of pool threads. This can be done while the pool is working.
+	 * New threads start on the client's jobs immediately. Surplus threads suspend or
+	 * finish their jobs and then exit. A pool working asynchronously keeps at least
+	 * one thread.
+	 * \param numThreads the number of threads, or AUTOMATIC_NUM_THREADS.
+	 */
+	void setNumThreads(int numThreads);
+	/*!
+	 * Get the number of pool threads.
+	 */
+	int getNumThreads() const;
+	/*!
+	 * Get the number of processors which are online.
+	 */
+	static int getNumProcessors();
+	/*!
+	 * Pin each pool thread to a processor, or release them. The processors the
+	 * process may run on are dealt out in turn, starting after the first, which is
+	 * left for the client thread.
+	 * A job's search allocates its memory on the thread doing the job, so with the
+	 * usual first-touch policy a pinned thread's memory stays on its NUMA node.
+	 * \return false if the threads could not be pinned.
+	 */
+	bool setPinned(bool pinned);
+	/*!
+	 * Get the timings collected since the pool was created or the stats were reset.
+	 */
+	WorkerPoolStats getStats() const;
+	/*!
+	 * Reset the timings.
+	 */
+	void resetStats();
 private:
+	/*!
+	 * Is the pool working for a client.
+	 */
+	bool isWorking() const;
+	/*!
+	 * Have all the client's jobs been done.
+	 * Must be called with the client lock held.
+	 */
+	bool isClientFinished() const;
+	/*!
+	 * Choose the next job for the worker, fetching jobs from the client as necessary.
+	 * Must be called with the client lock held.
+	 */
+	void takeNextJob(WorkerPoolMember* worker);
+	/*!
+	 * Suspend the lowest priority job being done by a pool thread if it is lower than 
+	 * the given priority and no pool thread is free to do the waiting job.
+	 * Must be called with the client lock held.
+	 */
+	void preemptFor(WorkerPoolJob::Priority priority);
+	/*!
+	 * Delete the jobs which have not been started or have been suspended.
+	 * Must be called with the client lock held.
+	 */
+	void discardWaitingJobs();
+	/*!
+	 * Stop the jobs of the client underway, whose results will be discarded,
+	 * and discard those waiting, so the client receives no more callbacks.
+	 * Must be called with the client lock held.
+	 */
+	void abandonClient();
+	/*!
+	 * The number of threads to use when the pool chooses: one fewer than the number 
+	 * of processors (for the client), less those processors busy with other work.
+	 * Must be called with the client lock held.
+	 */
+	int getAutomaticNumThreads() const;
+	/*!
+	 * Add or retire pool members.
+	 * Must be called with the client lock held.
+	 */
+	void resize(int numThreads);
+	/*!
+	 * Join the threads of retired pool members which have exited, or of all retired pool members.
+	 * Must be called without the client lock held.
+	 */
+	void joinRetiredMembers(bool all);
+	/*!
+	 * Pin the thread of the member at the given position in the pool, or let it run
+	 * on any of the process's processors.
+	 * \return false if that failed.
+	 */
+	bool pinMember(WorkerPoolMember* member, int position);
+	/*!
+	 * Take the client lock, adding any time spent waiting for it to the member's stats.
+	 */
+	void lockClient(WorkerPoolMember* member);
+	/*!
+	 * The time in seconds, from an arbitrary starting point.
+	 */
+	static double getTime();
 	/*!
 	 * Members of the pool.
 	 * These structures are also used as the argument passed to each thread as its starts.
 	 */
-	WorkerPoolMember* m_poolMembers;
+	std::vector<WorkerPoolMember*> m_poolMembers;
+	/*!
+	 * Members which have been removed from the pool, but whose threads have not yet been joined.
+	 */
+	std::vector<WorkerPoolMember*> m_retiredMembers;
+	/*!
+	 * Should the pool choose the number of threads itself.
+	 */
+	bool m_automaticNumThreads;
+	/*!
+	 * Are the pool threads pinned to processors.
+	 */
+	bool m_pinned;
+	/*!
+	 * The processors the process could run on when the pool was created.
+	 */
+	cpu_set_t m_processors;
 	/*!
-	 * The number of solver threads to use.
+	 * The number of jobs for the current client which are being done.
 	 */
-	int m_numPoolMembers;
+	int m_numJobsRunning;
 	/*!
-	 * The number of pool members currently doing jobs.
+	 * Incremented whenever a client releases the pool. Jobs started in
+	 * an earlier generation are stale, and their results are discarded.
 	 */
-	int m_numMembersWorking;
+	unsigned int m_generation;
 	/*!
 	 * The thread start point (which must be static). 
 	 */
 	static void* threadStartPoint(void* arg);
 	/*!
- 	 * Try to obtain a new problem and solve it.
- 	 * \return false if there was no problem to solve.
- 	 */
+	 * Try to obtain a new job and do it. 
+	 * Must be called with the client lock held, which is released while the job is done.
+	 * \return false if there was no job to do.
+	 * \throw anything the client's getNextJob throws, with the client lock held
+	 * and the client abandoned.
+	 */
 	bool doAJob(WorkerPoolMember* worker);
 	/*!
 	 * The states the worker pool can be in.
@@ -104,21 +237,43 @@ private:
 	 */
 	State m_state;
 	/*!
-	 * A lock which serializes access to the client.
+	 * Start working for the client. 
+	 * Must be called with the client lock held.
 	 */
-	pthread_mutex_t m_clientLock;
+	void startClient(WorkerPoolClient* client, State state);
 	/*!
-	 * When the threads are waiting for a new client, they wait on this.
+	 * A lock which serializes access to the client and the state of the pool.
 	 */
-	pthread_barrier_t m_startBarrier;
+	mutable pthread_mutex_t m_clientLock;
 	/*!
-	 * When there is no more work, we resynchronize the threads.
+	 * Idle pool threads wait on this for a new client or new jobs.
 	 */
-	pthread_barrier_t m_endBarrier;
+	pthread_cond_t m_workAvailable;
+	/*!
+	 * Signalled when the jobs of the client have all been done.
+	 */
+	pthread_cond_t m_workDone;
 	/*!
 	 * The client of the solver pool.
 	 */
 	WorkerPoolClient* m_client;
+	/*!
+	 * The next job obtained from the client, or NULL.
+	 */
+	WorkerPoolJob* m_nextClientJob;
+	/*!
+	 * Set when the client has no more jobs to give.
+	 */
+	bool m_clientHasNoMoreJobs;
+	/*!
+	 * Suspended jobs waiting to be resumed, in one queue per priority.
+	 */
+	std::deque<WorkerPoolJob*> m_suspendedJobs[WorkerPoolJob::NUM_PRIORITIES];
+	/*!
+	 * The timings of the client thread, of threads which have left the pool, and of jobs.
+	 * The timings of the current pool members are kept by the members.
+	 */
+	WorkerPoolStats m_stats;
 };
 
 } // namespace mzmslv
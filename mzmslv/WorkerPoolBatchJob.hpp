@@ -0,0 +1,166 @@
+/* ***************************************************************************
+ * WorkerPoolBatchJob.hpp
+ * Copyright (c) 2008, 2010, 2020 Malcolm Tyrrell.
+ * All rights reserved. This program and the accompanying materials
+ * are made available under the terms of the GNU Public License v3.0
+ * which accompanies this distribution, and is available at
+ * http://gplv3.fsf.org/
+ * ***************************************************************************/
+
+#ifndef WORKERPOOLBATCHJOB_H_
+#define WORKERPOOLBATCHJOB_H_
+
+#include <cstring>
+#include <vector>
+
+#include "WorkerPoolJob.hpp"
+
+namespace mzmslv {
+
+/*!
+ * A job which does a sequence of smaller jobs one after the other.
+ * When jobs are very quick, batching them saves the cost of passing each one
+ * through the pool separately.
+ */
+class WorkerPoolBatchJob : public WorkerPoolJob
+{
+public:
+	/*!
+	 * Constructor.
+	 */
+	WorkerPoolBatchJob();
+	/*!
+	 * Deletes the jobs in the batch.
+	 */
+	virtual ~WorkerPoolBatchJob();
+	/*!
+	 * Add a job to the end of the batch, which takes ownership of it.
+	 * This should be done before the batch is given to the pool.
+	 */
+	void addJob(WorkerPoolJob* job);
+	/*!
+	 * Get the number of jobs in the batch.
+	 */
+	int getNumJobs() const;
+	/*!
+	 * Get the ith job of the batch.
+	 */
+	WorkerPoolJob* getJob(int i) const;
+
+	// WorkerPoolJob interface.
+	virtual Outcome doJob();
+	virtual void stop();
+	virtual bool isSuspendable() const;
+	virtual void suspend();
+	virtual void resume();
+	virtual const char* getTypeName() const;
+private:
+	/*!
+	 * The jobs in the batch.
+	 */
+	std::vector<WorkerPoolJob*> m_jobs;
+	/*!
+	 * The number of jobs which have been finished.
+	 * The signals sent by the pool are passed to every job which is not finished,
+	 * so a job started just after a signal is sent still receives it.
+	 */
+	int m_numFinished;
+	/*!
+	 * Get the number of jobs which have been finished, from any thread.
+	 */
+	int getNumFinished() const;
+};
+
+//
+// Implementation.
+//
+
+inline WorkerPoolBatchJob::WorkerPoolBatchJob()
+: m_numFinished(0)
+{
+}
+
+inline WorkerPoolBatchJob::~WorkerPoolBatchJob()
+{
+	for (unsigned int i = 0; i < m_jobs.size(); ++i)
+		delete m_jobs[i];
+}
+
+inline void WorkerPoolBatchJob::addJob(WorkerPoolJob* job)
+{
+	m_jobs.push_back(job);
+}
+
+inline int WorkerPoolBatchJob::getNumJobs() const
+{
+	return m_jobs.size();
+}
+
+inline WorkerPoolJob* WorkerPoolBatchJob::getJob(int i) const
+{
+	return m_jobs[i];
+}
+
+inline int WorkerPoolBatchJob::getNumFinished() const
+{
+	// The signalling threads may read a stale value, which just means an extra job is signalled.
+	return __atomic_load_n(&m_numFinished, __ATOMIC_RELAXED);
+}
+
+inline WorkerPoolJob::Outcome WorkerPoolBatchJob::doJob()
+{
+	const int numJobs = m_jobs.size();
+	while (m_numFinished < numJobs) {
+		const Outcome outcome = m_jobs[m_numFinished]->doJob();
+		if (outcome != JOB_FINISHED)
+			return outcome;
+		__atomic_store_n(&m_numFinished, m_numFinished + 1, __ATOMIC_RELAXED);
+	}
+	return JOB_FINISHED;
+}
+
+inline void WorkerPoolBatchJob::stop()
+{
+	const int numJobs = m_jobs.size();
+	for (int i = getNumFinished(); i < numJobs; ++i)
+		m_jobs[i]->stop();
+}
+
+inline bool WorkerPoolBatchJob::isSuspendable() const
+{
+	const int numJobs = m_jobs.size();
+	for (int i = getNumFinished(); i < numJobs; ++i)
+		if (!m_jobs[i]->isSuspendable())
+			return false;
+	return true;
+}
+
+inline void WorkerPoolBatchJob::suspend()
+{
+	const int numJobs = m_jobs.size();
+	for (int i = getNumFinished(); i < numJobs; ++i)
+		m_jobs[i]->suspend();
+}
+
+inline void WorkerPoolBatchJob::resume()
+{
+	const int numJobs = m_jobs.size();
+	for (int i = getNumFinished(); i < numJobs; ++i)
+		m_jobs[i]->resume();
+}
+
+inline const char* WorkerPoolBatchJob::getTypeName() const
+{
+	// A batch of jobs of one type is named after them.
+	if (m_jobs.empty())
+		return "batch";
+	const char* name = m_jobs[0]->getTypeName();
+	for (unsigned int i = 1; i < m_jobs.size(); ++i)
+		if (std::strcmp(m_jobs[i]->getTypeName(), name) != 0)
+			return "mixed batch";
+	return name;
+}
+
+} // namespace mzmslv
+
+#endif /*WORKERPOOLBATCHJOB_H_*/
@@ -20,9 +20,26 @@ class WorkerPoolJob
 public:
 	enum Outcome {
 		JOB_FINISHED,
-		JOB_INTERRUPTED
+		JOB_INTERRUPTED,
+		JOB_SUSPENDED
 	};
 
+	/*!
+	 * The priority classes of jobs. When the pool has a choice, it runs jobs
+	 * of a higher class first, and may suspend running jobs of a lower class.
+	 */
+	enum Priority {
+		PRIORITY_LOW,
+		PRIORITY_NORMAL,
+		PRIORITY_HIGH,
+		NUM_PRIORITIES
+	};
+
+	/*!
+	 * Constructor.
+	 */
+	WorkerPoolJob() : m_priority(PRIORITY_NORMAL) {}
+
 	/*!
 	 * Do the job and return the outcome.
 	 */
@@ -34,10 +51,48 @@ public:
 	 */
 	virtual void stop() = 0;
 	
+	/*!
+	 * Can the job be suspended?
+	 */
+	virtual bool isSuspendable() const { return false; }
+	
+	/*!
+	 * Should signal the worker doing the job that it should stop as
+	 * soon as possible and return JOB_SUSPENDED, keeping enough state 
+	 * to continue where it left off. Only called if isSuspendable.
+	 */
+	virtual void suspend() {}
+	
+	/*!
+	 * Called before a suspended job is done again.
+	 */
+	virtual void resume() {}
+	
+	/*!
+	 * A name for the type of the job, used to group jobs in the pool's stats.
+	 */
+	virtual const char* getTypeName() const { return "job"; }
+	
+	/*!
+	 * Get the priority of the job.
+	 */
+	Priority getPriority() const { return m_priority; }
+	
+	/*!
+	 * Set the priority of the job. This should be done before the job
+	 * is given to the pool.
+	 */
+	void setPriority(Priority priority) { m_priority = priority; }
+	
 	/*!
 	 * Virtual destructor.
 	 */
 	virtual ~WorkerPoolJob() {}
+private:
+	/*!
+	 * The priority of the job.
+	 */
+	Priority m_priority;
 };
 
 } // namespace mzmslv
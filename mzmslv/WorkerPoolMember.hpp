@@ -10,6 +10,8 @@
 #ifndef WORKERPOOLMEMBER_H_
 #define WORKERPOOLMEMBER_H_
 
+#include "WorkerPoolStats.hpp"
+
 namespace mzmslv {
 
 class WorkerPool;
@@ -28,6 +30,26 @@ public:
 	 * A pointer to the job currently being done, or NULL. 
 	 */
 	WorkerPoolJob* m_job;
+	/*!
+	 * Set when the job has been asked to suspend itself. 
+	 */
+	bool m_preempted;
+	/*!
+	 * The generation of the pool in which the job was started.
+	 */
+	unsigned int m_generation;
+	/*!
+	 * Set when the member has been removed from the pool and should exit.
+	 */
+	bool m_retiring;
+	/*!
+	 * Set when the member's thread has finished.
+	 */
+	bool m_exited;
+	/*!
+	 * How the member's thread has spent its time.
+	 */
+	WorkerPoolStats::ThreadStats m_stats;
 	/*!
 	 * The owning worker pool.
 	 */
@@ -0,0 +1,115 @@
+/* ***************************************************************************
+ * WorkerPoolStats.cpp
+ * Copyright (c) 2008, 2010, 2020 Malcolm Tyrrell.
+ * All rights reserved. This program and the accompanying materials
+ * are made available under the terms of the GNU Public License v3.0
+ * which accompanies this distribution, and is available at
+ * http://gplv3.fsf.org/
+ * ***************************************************************************/
+
+#include "WorkerPoolStats.hpp"
+
+#include <iomanip>
+#include <sstream>
+
+namespace mzmslv {
+
+WorkerPoolStats::ThreadStats::ThreadStats()
+: m_numJobs(0)
+, m_busyTime(0)
+, m_idleTime(0)
+, m_lockWaitTime(0)
+, m_barrierWaitTime(0)
+{
+}
+
+void WorkerPoolStats::ThreadStats::add(const ThreadStats& other)
+{
+	m_numJobs += other.m_numJobs;
+	m_busyTime += other.m_busyTime;
+	m_idleTime += other.m_idleTime;
+	m_lockWaitTime += other.m_lockWaitTime;
+	m_barrierWaitTime += other.m_barrierWaitTime;
+}
+
+WorkerPoolStats::Histogram::Histogram()
+: m_totalTime(0)
+{
+	for (int i = 0; i < NUM_BUCKETS; ++i)
+		m_count[i] = 0;
+}
+
+void WorkerPoolStats::Histogram::add(double seconds)
+{
+	const double microseconds = seconds * 1e6;
+	int bucket = 0;
+	for (double bound = 1; (bucket < NUM_BUCKETS - 1) && (microseconds >= bound); bound *= 2)
+		++bucket;
+	++m_count[bucket];
+	m_totalTime += seconds;
+}
+
+void WorkerPoolStats::Histogram::add(const Histogram& other)
+{
+	for (int i = 0; i < NUM_BUCKETS; ++i)
+		m_count[i] += other.m_count[i];
+	m_totalTime += other.m_totalTime;
+}
+
+/*!
+ * Write one row of the thread table.
+ */
+static void writeThreadStats(std::ostream& os, const std::string& name, const WorkerPoolStats::ThreadStats& stats)
+{
+	const double total = stats.m_busyTime + stats.m_idleTime + stats.m_lockWaitTime + stats.m_barrierWaitTime;
+	os << std::setw(8) << name
+		<< std::setw(9) << stats.m_numJobs
+		<< std::setw(10) << stats.m_busyTime
+		<< std::setw(10) << stats.m_idleTime
+		<< std::setw(10) << stats.m_lockWaitTime
+		<< std::setw(10) << stats.m_barrierWaitTime
+		<< std::setw(7) << ((total > 0) ? static_cast<int>(100 * stats.m_busyTime / total + 0.5) : 0) << "%\n";
+}
+
+std::ostream& operator<< (std::ostream& os, const WorkerPoolStats& stats)
+{
+	const std::ios_base::fmtflags flags = os.flags();
+	const std::streamsize precision = os.precision();
+	os << std::fixed << std::setprecision(3);
+
+	os << "  thread     jobs   busy(s)   idle(s)   lock(s)   wait(s)   busy\n";
+	writeThreadStats(os, "client", stats.m_clientThread);
+	WorkerPoolStats::ThreadStats total = stats.m_clientThread;
+	for (unsigned int i = 0; i < stats.m_poolThreads.size(); ++i) {
+		std::ostringstream name;
+		name << (i + 1);
+		writeThreadStats(os, name.str(), stats.m_poolThreads[i]);
+		total.add(stats.m_poolThreads[i]);
+	}
+	writeThreadStats(os, "total", total);
+
+	for (std::map<std::string, WorkerPoolStats::Histogram>::const_iterator i = stats.m_jobTimes.begin(); i != stats.m_jobTimes.end(); ++i) {
+		const WorkerPoolStats::Histogram& histogram = i->second;
+		unsigned int numJobs = 0;
+		for (int b = 0; b < WorkerPoolStats::Histogram::NUM_BUCKETS; ++b)
+			numJobs += histogram.m_count[b];
+		os << "Job times (" << i->first << "): " << numJobs << " jobs, " << histogram.m_totalTime << "s\n";
+		double bound = 1;
+		for (int b = 0; b < WorkerPoolStats::Histogram::NUM_BUCKETS; ++b, bound *= 2) {
+			if (histogram.m_count[b] == 0)
+				continue;
+			if (b < WorkerPoolStats::Histogram::NUM_BUCKETS - 1)
+				os << "  <" << std::setw(10) << std::setprecision(0) << bound << "us: ";
+			else
+				os << "  >=" << std::setw(9) << std::setprecision(0) << bound / 2 << "us: ";
+			os << histogram.m_count[b] << "\n";
+		}
+		os << std::setprecision(3);
+	}
+
+	os.flags(flags);
+	os.precision(precision);
+	return os;
+}
+
+} // namespace mzmslv
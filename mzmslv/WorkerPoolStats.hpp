@@ -0,0 +1,109 @@
+/* ***************************************************************************
+ * WorkerPoolStats.hpp
+ * Copyright (c) 2008, 2010, 2020 Malcolm Tyrrell.
+ * All rights reserved. This program and the accompanying materials
+ * are made available under the terms of the GNU Public License v3.0
+ * which accompanies this distribution, and is available at
+ * http://gplv3.fsf.org/
+ * ***************************************************************************/
+
+#ifndef WORKERPOOLSTATS_H_
+#define WORKERPOOLSTATS_H_
+
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace mzmslv {
+
+/*!
+ * Timings collected by a worker pool, so one can tell whether the pool was
+ * kept busy, or its threads spent their time waiting for work or for each other.
+ * All times are in seconds.
+ */
+class WorkerPoolStats
+{
+public:
+	/*!
+	 * How a thread which works for the pool spent its time.
+	 */
+	struct ThreadStats {
+		ThreadStats();
+		/*!
+		 * Add the times of another thread to these.
+		 */
+		void add(const ThreadStats& other);
+		/*!
+		 * The number of times the thread did a job. A job which is suspended
+		 * and resumed is counted each time it is done.
+		 */
+		unsigned int m_numJobs;
+		/*!
+		 * The time spent doing jobs.
+		 */
+		double m_busyTime;
+		/*!
+		 * The time spent waiting for jobs to be available.
+		 */
+		double m_idleTime;
+		/*!
+		 * The time spent waiting to take the pool's client lock.
+		 */
+		double m_lockWaitTime;
+		/*!
+		 * The time the client thread spent waiting for the pool threads to finish the client's jobs.
+		 */
+		double m_barrierWaitTime;
+	};
+	/*!
+	 * A histogram of how long jobs took, with power of two buckets.
+	 */
+	struct Histogram {
+		Histogram();
+		/*!
+		 * Record a time.
+		 */
+		void add(double seconds);
+		/*!
+		 * Add the counts of another histogram to these.
+		 */
+		void add(const Histogram& other);
+		/*!
+		 * The number of buckets.
+		 */
+		static const int NUM_BUCKETS = 32;
+		/*!
+		 * The number of times in bucket i, which holds times under 2^i microseconds
+		 * and (except for the first) at least 2^(i-1) microseconds. The last bucket
+		 * also holds any longer times.
+		 */
+		unsigned int m_count[NUM_BUCKETS];
+		/*!
+		 * The total of the times recorded.
+		 */
+		double m_totalTime;
+	};
+	/*!
+	 * The thread of the client, which does jobs when the pool works synchronously.
+	 */
+	ThreadStats m_clientThread;
+	/*!
+	 * The pool threads, in the order they were created. Threads which have left
+	 * the pool are included.
+	 */
+	std::vector<ThreadStats> m_poolThreads;
+	/*!
+	 * The times taken to do jobs, by the type name of the job.
+	 */
+	std::map<std::string, Histogram> m_jobTimes;
+};
+
+/*!
+ * Write a summary of the stats to an ostream.
+ */
+std::ostream& operator<< (std::ostream& os, const WorkerPoolStats& stats);
+
+} // namespace mzmslv
+
+#endif /*WORKERPOOLSTATS_H_*/